@@ -0,0 +1,153 @@
+#include <torch_points/collate/pad.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/hash.h>
+
+namespace torch_points {
+
+std::pair<torch::Tensor,torch::Tensor> pad_batch(
+    std::vector<torch::Tensor> samples,
+    int Nmax,
+    const std::string& mode,
+    int64_t seed,
+    bool pin_memory)
+{
+    TORCH_CHECK(not samples.empty(), "samples must not be empty");
+    TORCH_CHECK(mode == "zero" or mode == "repeat" or mode == "random", "mode must be zero, repeat or random");
+    const auto& first = samples.front();
+    TORCH_CHECK(1 <= first.dim(), "samples must have at least one dimension");
+    for(const auto& sample : samples)
+    {
+        CHECK_CONTIGUOUS(sample);
+        TORCH_CHECK(sample.scalar_type() == first.scalar_type(), "samples must have the same dtype");
+        TORCH_CHECK(sample.dim() == first.dim(), "samples must have the same number of dimensions");
+        for(int d = 1; d < sample.dim(); ++d)
+            TORCH_CHECK(sample.size(d) == first.size(d), "samples must have the same trailing sizes");
+    }
+    DISPATCH(first.device(), pad_batch, samples, Nmax, mode, seed, pin_memory);
+}
+
+std::pair<torch::Tensor,torch::Tensor> pad_batch_cpu(
+    std::vector<torch::Tensor> samples,
+    int Nmax,
+    const std::string& mode,
+    int64_t seed,
+    bool pin_memory)
+{
+    const int B = samples.size();
+    std::vector<int64_t> lengths(B);
+    std::vector<const char*> sources(B);
+    for(int b = 0; b < B; ++b) {
+        CHECK_CPU(samples[b]);
+        lengths[b] = samples[b].size(0);
+        sources[b] = static_cast<const char*>(samples[b].data_ptr());
+    }
+    if(Nmax <= 0)
+        Nmax = *std::max_element(lengths.begin(), lengths.end());
+
+    const auto first_sizes = samples.front().sizes();
+    std::vector<int64_t> sizes = {B, Nmax};
+    sizes.insert(sizes.end(), first_sizes.begin() + 1, first_sizes.end());
+    int64_t row = samples.front().element_size();
+    for(size_t d = 2; d < sizes.size(); ++d)
+        row *= sizes[d];
+    auto padded = torch::empty(sizes, samples.front().options().pinned_memory(pin_memory));
+    auto mask = torch::empty({B,Nmax}, torch::TensorOptions(torch::kBool).pinned_memory(pin_memory));
+    char* padded_ptr = static_cast<char*>(padded.data_ptr());
+    bool* mask_ptr = mask.data_ptr<bool>();
+
+    const int fill = mode == "zero" ? 0 : mode == "repeat" ? 1 : 2;
+    const int64_t R = int64_t(B) * Nmax;
+    at::parallel_for(0, R, 1024, [&](int64_t begin, int64_t end)
+    {
+        int64_t r = begin;
+        while(r < end)
+        {
+            const int b = r / Nmax;
+            const int64_t j = r % Nmax;
+            const int64_t n = lengths[b];
+            char* dst = padded_ptr + r * row;
+            if(j < n)
+            {
+                // rows j:j+count of the sample
+                const int64_t count = std::min(std::min(n, int64_t(Nmax)) - j, end - r);
+                std::memcpy(dst, sources[b] + j * row, count * row);
+                std::fill(mask_ptr + r, mask_ptr + r + count, true);
+                r += count;
+            }
+            else
+            {
+                const int64_t count = std::min(Nmax - j, end - r);
+                std::fill(mask_ptr + r, mask_ptr + r + count, false);
+                if(fill == 0 or n == 0) {
+                    std::memset(dst, 0, count * row);
+                } else {
+                    for(int64_t k = 0; k < count; ++k) {
+                        const int64_t src = fill == 1 
+                            ? (j + k) % n 
+                            : hash64(seed, uint64_t(b) * Nmax + j + k) % n;
+                        std::memcpy(dst + k * row, sources[b] + src * row, row);
+                    }
+                }
+                r += count;
+            }
+        }
+    });
+    return std::make_pair(padded, mask);
+}
+
+std::pair<torch::Tensor,torch::Tensor> unpad(
+    torch::Tensor padded,
+    torch::Tensor lengths)
+{
+    CHECK_CONTIGUOUS(padded);
+    TORCH_CHECK(2 <= padded.dim(), "padded must have size [B,Nmax,...]");
+    TORCH_CHECK(lengths.device().is_cpu(), "lengths must be a CPU tensor");
+    TORCH_CHECK(lengths.dim() == 1 and lengths.size(0) == padded.size(0), "lengths must have size [B]");
+    DISPATCH(padded.device(), unpad, padded, lengths);
+}
+
+std::pair<torch::Tensor,torch::Tensor> unpad_cpu(
+    torch::Tensor padded,
+    torch::Tensor lengths)
+{
+    CHECK_CPU(padded);
+    const int B = padded.size(0);
+    const int Nmax = padded.size(1);
+    const auto lengths32 = lengths.to(torch::kInt32).contiguous();
+    const int* lengths_ptr = lengths32.data_ptr<int>();
+    auto offsets = torch::empty({B + 1}, torch::kInt32);
+    int* offsets_ptr = offsets.data_ptr<int>();
+    offsets_ptr[0] = 0;
+    for(int b = 0; b < B; ++b)
+    {
+        TORCH_CHECK(0 <= lengths_ptr[b] and lengths_ptr[b] <= Nmax, "lengths must be in [0,Nmax]");
+        offsets_ptr[b+1] = offsets_ptr[b] + lengths_ptr[b];
+    }
+
+    const auto padded_sizes = padded.sizes();
+    std::vector<int64_t> sizes(padded_sizes.begin() + 1, padded_sizes.end());
+    sizes[0] = offsets_ptr[B];
+    int64_t row = padded.element_size();
+    for(size_t d = 1; d < sizes.size(); ++d)
+        row *= sizes[d];
+    auto values = torch::empty(sizes, padded.options());
+    const char* padded_ptr = static_cast<const char*>(padded.data_ptr());
+    char* values_ptr = static_cast<char*>(values.data_ptr());
+
+    // parallel over the rows of the output, one memcpy per sample in a chunk
+    at::parallel_for(0, offsets_ptr[B], 1024, [&](int64_t begin, int64_t end)
+    {
+        int b = std::upper_bound(offsets_ptr, offsets_ptr + B + 1, begin) - offsets_ptr - 1;
+        for(int64_t i = begin; i < end; ++b)
+        {
+            const int64_t count = std::min<int64_t>(offsets_ptr[b+1], end) - i;
+            const int64_t j = i - offsets_ptr[b];
+            std::memcpy(values_ptr + i * row, padded_ptr + (int64_t(b) * Nmax + j) * row, count * row);
+            i += count;
+        }
+    });
+    return std::make_pair(values, offsets);
+}
+
+} // namespace torch_points
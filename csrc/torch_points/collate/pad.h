@@ -0,0 +1,59 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// padding of variable-size samples into a dense batch
+//
+// samples: B tensors (N_b,...) of the same dtype and trailing sizes
+// Nmax:    rows of the batch, max N_b if Nmax <= 0, longer samples are truncated
+// mode:    rows after the end of a sample are
+//          "zero":   zeros
+//          "repeat": the rows of the sample repeated cyclically
+//          "random": random rows of the sample, the row j of the sample b only
+//                    depends on seed, b and j
+//          rows of empty samples are zeros
+// pin_memory: the batch is allocated in pinned memory
+//
+// returns
+//      padded: (B,Nmax,...)
+//      mask:   bool (B,Nmax): true for the rows of the samples
+//
+// the batch is written in one parallel pass over its rows, consecutive rows of
+// a sample are copied by a single memcpy
+//
+std::pair<torch::Tensor,torch::Tensor> pad_batch(
+    std::vector<torch::Tensor> samples,
+    int Nmax,
+    const std::string& mode,
+    int64_t seed,
+    bool pin_memory);
+
+std::pair<torch::Tensor,torch::Tensor> pad_batch_cpu(
+    std::vector<torch::Tensor> samples,
+    int Nmax,
+    const std::string& mode,
+    int64_t seed,
+    bool pin_memory);
+
+//
+// inverse of pad_batch
+//
+// padded:  (B,Nmax,...)
+// lengths: int (B): number of rows of each sample
+//
+// returns
+//      values:  (N,...): rows of the samples, concatenated
+//      offsets: int (B+1): rows offsets[b]:offsets[b+1] are the sample b
+//
+std::pair<torch::Tensor,torch::Tensor> unpad(
+    torch::Tensor padded,
+    torch::Tensor lengths);
+
+std::pair<torch::Tensor,torch::Tensor> unpad_cpu(
+    torch::Tensor padded,
+    torch::Tensor lengths);
+
+} // namespace torch_points
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// offsets (B+1) of the samples of N points given a sorted batch vector (N)
+// of any integer dtype, B = batch[N-1]+1
+// without batch vector all the points are in one sample
+//
+inline std::vector<int> batch_to_offsets(torch::optional<torch::Tensor> batch, int N)
+{
+    if(not batch.has_value())
+        return {0, N};
+    TORCH_CHECK(batch->device().is_cpu(), "batch must be a CPU tensor");
+    TORCH_CHECK(batch->dim() == 1 and batch->size(0) == N, "batch must have size [N]");
+    const auto batch64 = batch->to(torch::kInt64).contiguous();
+    const int64_t* batch_ptr = batch64.data_ptr<int64_t>();
+    const int B = N == 0 ? 0 : batch_ptr[N-1] + 1;
+    std::vector<int> offsets(B + 1, 0);
+    for(int i = 0; i < N; ++i)
+    {
+        TORCH_CHECK(0 <= batch_ptr[i] and (i == 0 or batch_ptr[i-1] <= batch_ptr[i]), 
+            "batch must be sorted and non-negative");
+        ++offsets[batch_ptr[i] + 1];
+    }
+    for(int b = 0; b < B; ++b)
+        offsets[b+1] += offsets[b];
+    return offsets;
+}
+
+//
+// offsets (B+1) of the samples of N points given an int offsets tensor (B+1)
+// without offsets all the points are in one sample
+//
+inline std::vector<int> check_offsets(torch::optional<torch::Tensor> offsets, int N)
+{
+    if(not offsets.has_value())
+        return {0, N};
+    TORCH_CHECK(offsets->device().is_cpu(), "offsets must be a CPU tensor");
+    TORCH_CHECK(offsets->dim() == 1 and 1 <= offsets->size(0), "offsets must have size [B+1]");
+    const auto offsets32 = offsets->to(torch::kInt32).contiguous();
+    const int* offsets_ptr = offsets32.data_ptr<int>();
+    std::vector<int> result(offsets_ptr, offsets_ptr + offsets32.size(0));
+    TORCH_CHECK(result.front() == 0 and result.back() == N, "offsets must start at 0 and end at N");
+    for(size_t b = 1; b < result.size(); ++b)
+        TORCH_CHECK(result[b-1] <= result[b], "offsets must be sorted");
+    return result;
+}
+
+// sample of each point
+inline std::vector<int> offsets_to_batch(const std::vector<int>& offsets)
+{
+    std::vector<int> batch(offsets.back());
+    for(size_t b = 0; b + 1 < offsets.size(); ++b)
+        std::fill(batch.begin() + offsets[b], batch.begin() + offsets[b+1], b);
+    return batch;
+}
+
+} // namespace torch_points
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// long (M) indices of the true entries of mask (N), in increasing order
+// each chunk counts its entries, then writes them at its offset
+//
+inline torch::Tensor mask_to_indices(const bool* mask, int64_t N)
+{
+    const int64_t T = std::max<int64_t>(1, std::min<int64_t>(at::get_num_threads(), N / 16384));
+    const int64_t chunk = (N + T - 1) / T;
+    std::vector<int64_t> offsets(T + 1, 0);
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+            for(int64_t i = t * chunk; i < std::min(N, (t+1) * chunk); ++i)
+                offsets[t+1] += mask[i];
+    });
+    for(int64_t t = 0; t < T; ++t)
+        offsets[t+1] += offsets[t];
+
+    auto indices = torch::empty({offsets[T]}, torch::kInt64);
+    int64_t* indices_ptr = indices.data_ptr<int64_t>();
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+        {
+            int64_t k = offsets[t];
+            for(int64_t i = t * chunk; i < std::min(N, (t+1) * chunk); ++i)
+                if(mask[i])
+                    indices_ptr[k++] = i;
+        }
+    });
+    return indices;
+}
+
+} // namespace torch_points
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// stable counting sort of N keys in [0,K)
+//
+// offsets: (K+1) begin/end of each key in order
+// order:   (N)   indices of keys sorted by key, ties keep their input order
+//
+// each thread counts a contiguous chunk of keys in its own histogram,
+// the number of chunks is limited so that the histograms hold at most
+// max(4N,K) counts
+//
+inline void counting_sort(
+    const int* keys,
+    int N,
+    int K,
+    int* offsets,
+    int* order)
+{
+    const int64_t T = std::max<int64_t>(1, std::min<int64_t>(
+        at::get_num_threads(),
+        4 * int64_t(N) / std::max(K, 1)));
+    const int64_t chunk = (N + T - 1) / T;
+    std::vector<int> counts(T * K, 0); // counts[t*K+k]
+
+    // 1. per chunk histograms
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+        {
+            int* c = counts.data() + t * K;
+            const int64_t end = std::min<int64_t>(N, (t+1) * chunk);
+            for(int64_t i = t * chunk; i < end; ++i)
+                ++c[keys[i]];
+        }
+    });
+
+    // 2. exclusive scan in (key,chunk) order
+    at::parallel_for(0, K, 2048, [&](int64_t k_begin, int64_t k_end)
+    {
+        for(int64_t k = k_begin; k < k_end; ++k)
+        {
+            int sum = 0;
+            for(int64_t t = 0; t < T; ++t)
+                sum += counts[t * K + k];
+            offsets[k+1] = sum;
+        }
+    });
+    offsets[0] = 0;
+    for(int k = 0; k < K; ++k)
+        offsets[k+1] += offsets[k];
+    at::parallel_for(0, K, 2048, [&](int64_t k_begin, int64_t k_end)
+    {
+        for(int64_t k = k_begin; k < k_end; ++k)
+        {
+            int pos = offsets[k];
+            for(int64_t t = 0; t < T; ++t)
+            {
+                const int count = counts[t * K + k];
+                counts[t * K + k] = pos;
+                pos += count;
+            }
+        }
+    });
+
+    // 3. scatter
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+        {
+            int* c = counts.data() + t * K;
+            const int64_t end = std::min<int64_t>(N, (t+1) * chunk);
+            for(int64_t i = t * chunk; i < end; ++i)
+                order[c[keys[i]]++] = i;
+        }
+    });
+}
+
+} // namespace torch_points
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// rows indices[0:M] of a contiguous tensor input (N,...) of any dtype
+// rows are copied in parallel
+//
+template<typename IndexT>
+torch::Tensor gather_rows(torch::Tensor input, const IndexT* indices, int64_t M)
+{
+    const auto input_sizes = input.sizes();
+    std::vector<int64_t> sizes(input_sizes.begin(), input_sizes.end());
+    sizes[0] = M;
+    auto output = torch::empty(sizes, input.options());
+    const int64_t row = input.size(0) == 0 ? 0 : input.numel() / input.size(0) * input.element_size();
+    const char* src = static_cast<const char*>(input.data_ptr());
+    char* dst = static_cast<char*>(output.data_ptr());
+    at::parallel_for(0, M, 1024, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            std::memcpy(dst + i * row, src + int64_t(indices[i]) * row, row);
+    });
+    return output;
+}
+
+} // namespace torch_points
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace torch_points {
+
+//
+// counter-based random numbers: the i-th value of the stream of seed,
+// computed independently of the others so parallel loops are deterministic
+//
+
+// splitmix64
+inline uint64_t hash64(uint64_t seed, uint64_t i)
+{
+    uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// uniform in (0,1) from the 24 high bits
+inline float hash_uniform(uint64_t h)
+{
+    return ((h >> 40) + 0.5f) * (1.f / 16777216.f);
+}
+
+} // namespace torch_points
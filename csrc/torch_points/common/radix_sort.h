@@ -0,0 +1,65 @@
+#pragma once
+
+#include <torch_points/common/counting_sort.h>
+
+namespace torch_points {
+
+//
+// stable LSD radix sort of N keys using their lowest bits only
+// one parallel counting sort per byte
+//
+// sorted_keys: (N) keys in increasing order
+// order:       (N) indices of keys in increasing order
+//
+inline void radix_sort(
+    const uint64_t* keys,
+    int N,
+    int bits,
+    uint64_t* sorted_keys,
+    int* order)
+{
+    std::vector<uint64_t> tmp_keys(N);
+    std::vector<int> tmp_order(N);
+    std::vector<int> digits(N);
+    std::vector<int> positions(N);
+    std::vector<int> offsets(257);
+
+    uint64_t* cur_keys = sorted_keys;
+    int* cur_order = order;
+    uint64_t* next_keys = tmp_keys.data();
+    int* next_order = tmp_order.data();
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i) {
+            cur_keys[i] = keys[i];
+            cur_order[i] = i;
+        }
+    });
+
+    for(int shift = 0; shift < bits; shift += 8)
+    {
+        at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t i = begin; i < end; ++i)
+                digits[i] = (cur_keys[i] >> shift) & 0xff;
+        });
+        counting_sort(digits.data(), N, 256, offsets.data(), positions.data());
+        at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t i = begin; i < end; ++i) {
+                next_keys[i] = cur_keys[positions[i]];
+                next_order[i] = cur_order[positions[i]];
+            }
+        });
+        std::swap(cur_keys, next_keys);
+        std::swap(cur_order, next_order);
+    }
+
+    if(cur_keys != sorted_keys)
+    {
+        std::copy(cur_keys, cur_keys + N, sorted_keys);
+        std::copy(cur_order, cur_order + N, order);
+    }
+}
+
+} // namespace torch_points
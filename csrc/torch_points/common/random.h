@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+namespace torch_points {
+
+//
+// m sorted indices among [0,n) written in out, drawn uniformly without replacement
+// Floyd's algorithm is used when few indices are selected, otherwise a
+// sequential selection in one pass over the indices
+//
+template<typename IndexT>
+void sample_indices(int n, int m, std::mt19937_64& rng, IndexT* out)
+{
+    if(16 * int64_t(m) < n)
+    {
+        // Floyd's algorithm, O(m) memory
+        std::unordered_set<int> selected;
+        selected.reserve(2 * m);
+        for(int j = n - m; j < n; ++j)
+        {
+            const int t = std::uniform_int_distribution<int>(0, j)(rng);
+            if(not selected.insert(t).second)
+                selected.insert(j);
+        }
+        std::copy(selected.begin(), selected.end(), out);
+        std::sort(out, out + m);
+    }
+    else
+    {
+        // selection sampling, each index is kept with probability
+        // (number of indices still needed) / (number of indices left)
+        int k = 0;
+        for(int i = 0; i < n and k < m; ++i)
+        {
+            const int left = n - i;
+            if(std::uniform_int_distribution<int>(0, left - 1)(rng) < m - k)
+                out[k++] = i;
+        }
+    }
+}
+
+// generator of the stream s of seed, so that streams drawn in parallel do not
+// depend on the number of threads
+inline std::mt19937_64 make_generator(int64_t seed, uint32_t s)
+{
+    std::seed_seq seq = {uint32_t(seed), uint32_t(uint64_t(seed) >> 32), s};
+    return std::mt19937_64(seq);
+}
+
+} // namespace torch_points
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace torch_points {
+namespace internal {
+
+//
+// closed-form eigen decomposition of a 3x3 symmetric matrix
+// stored as a = {xx, xy, xz, yy, yz, zz}
+//
+
+// eigenvalues in increasing order (trigonometric solution of the characteristic polynomial)
+inline void eigenvalues(const double a[6], double e[3])
+{
+    const double p1 = a[1]*a[1] + a[2]*a[2] + a[4]*a[4];
+    const double q = (a[0] + a[3] + a[5]) / 3;
+    const double p2 = (a[0]-q)*(a[0]-q) + (a[3]-q)*(a[3]-q) + (a[5]-q)*(a[5]-q) + 2*p1;
+    const double p = std::sqrt(p2 / 6);
+    if(p == 0) {
+        e[0] = e[1] = e[2] = q;
+        return;
+    }
+    // B = (A - qI) / p, r = det(B) / 2
+    const double b0 = (a[0]-q) / p, b1 = a[1] / p, b2 = a[2] / p;
+    const double b3 = (a[3]-q) / p, b4 = a[4] / p, b5 = (a[5]-q) / p;
+    const double det = b0*(b3*b5 - b4*b4) - b1*(b1*b5 - b4*b2) + b2*(b1*b4 - b3*b2);
+    const double r = std::min(std::max(det / 2, -1.), 1.);
+    const double phi = std::acos(r) / 3;
+    e[2] = q + 2 * p * std::cos(phi);
+    e[0] = q + 2 * p * std::cos(phi + 2 * M_PI / 3);
+    e[1] = 3 * q - e[0] - e[2];
+}
+
+// unit eigenvector of the eigenvalue lambda, any unit vector orthogonal to the
+// other eigenvectors if lambda is repeated, (0,0,1) for a scalar matrix
+inline void eigenvector(const double a[6], double lambda, double v[3])
+{
+    // rows of A - lambda I
+    const double r[3][3] = {
+        {a[0] - lambda, a[1], a[2]},
+        {a[1], a[3] - lambda, a[4]},
+        {a[2], a[4], a[5] - lambda}};
+    const auto cross = [](const double* u, const double* w, double* out) {
+        out[0] = u[1]*w[2] - u[2]*w[1];
+        out[1] = u[2]*w[0] - u[0]*w[2];
+        out[2] = u[0]*w[1] - u[1]*w[0];
+    };
+    const auto norm2 = [](const double* u) { return u[0]*u[0] + u[1]*u[1] + u[2]*u[2]; };
+
+    // the eigenvector is orthogonal to the rows, take the best conditioned cross product
+    double c[3][3];
+    cross(r[0], r[1], c[0]);
+    cross(r[0], r[2], c[1]);
+    cross(r[1], r[2], c[2]);
+    int best = 0;
+    for(int k = 1; k < 3; ++k)
+        if(norm2(c[best]) < norm2(c[k]))
+            best = k;
+    double n = norm2(c[best]);
+    const double scale = std::max({norm2(r[0]), norm2(r[1]), norm2(r[2])});
+    if(scale * scale * 1e-20 < n) {
+        n = std::sqrt(n);
+        for(int d = 0; d < 3; ++d)
+            v[d] = c[best][d] / n;
+        return;
+    }
+
+    // repeated eigenvalue: orthogonal to the largest row
+    int row = 0;
+    for(int k = 1; k < 3; ++k)
+        if(norm2(r[row]) < norm2(r[k]))
+            row = k;
+    if(norm2(r[row]) == 0) {
+        v[0] = 0; v[1] = 0; v[2] = 1;
+        return;
+    }
+    // cross product with the axis least aligned with the row
+    const double* u = r[row];
+    int axis = 0;
+    for(int d = 1; d < 3; ++d)
+        if(std::abs(u[d]) < std::abs(u[axis]))
+            axis = d;
+    double e[3] = {0, 0, 0};
+    e[axis] = 1;
+    cross(u, e, v);
+    n = std::sqrt(norm2(v));
+    for(int d = 0; d < 3; ++d)
+        v[d] /= n;
+}
+
+} // namespace internal
+} // namespace torch_points
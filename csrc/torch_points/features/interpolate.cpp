@@ -0,0 +1,181 @@
+#include <torch_points/features/interpolate.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+namespace torch_points {
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> three_interpolate(
+    torch::Tensor dense_points,
+    torch::Tensor coarse_points,
+    torch::Tensor coarse_features)
+{
+    CHECK_CONTIGUOUS(dense_points);
+    CHECK_CONTIGUOUS(coarse_points);
+    CHECK_CONTIGUOUS(coarse_features);
+    const int dim = dense_points.dim();
+    TORCH_CHECK((dim == 2 or dim == 3) and dense_points.size(-1) == 3, 
+        "dense_points must have size [N,3] or [B,N,3]");
+    TORCH_CHECK(coarse_points.dim() == dim and coarse_points.size(-1) == 3, 
+        "coarse_points must have size [M,3] or [B,M,3]");
+    TORCH_CHECK(coarse_features.dim() == dim and coarse_features.size(-2) == coarse_points.size(-2), 
+        "coarse_features must have size [M,C] or [B,M,C]");
+    TORCH_CHECK(coarse_features.dtype() == torch::kFloat32, "coarse_features must be float");
+    TORCH_CHECK(dim == 2 or (dense_points.size(0) == coarse_points.size(0) 
+        and coarse_points.size(0) == coarse_features.size(0)), 
+        "dense_points, coarse_points and coarse_features must have the same batch size");
+    DISPATCH(dense_points.device(), three_interpolate, dense_points, coarse_points, coarse_features);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> three_interpolate_cpu(
+    torch::Tensor dense_points,
+    torch::Tensor coarse_points,
+    torch::Tensor coarse_features)
+{
+    CHECK_CPU(dense_points);
+    CHECK_CPU(coarse_points);
+    CHECK_CPU(coarse_features);
+    const bool batched = dense_points.dim() == 3;
+    const int B = batched ? dense_points.size(0) : 1;
+    const int N = dense_points.size(-2);
+    const int M = coarse_points.size(-2);
+    const int C = coarse_features.size(-1);
+    const float* dense_ptr = dense_points.data_ptr<float>();
+    const float* coarse_ptr = coarse_points.data_ptr<float>();
+    const float* coarse_features_ptr = coarse_features.data_ptr<float>();
+
+    std::vector<int> offsets(B + 1);
+    for(int b = 0; b <= B; ++b)
+        offsets[b] = b * M;
+    const auto grids = internal::build_grids(coarse_ptr, offsets, 0);
+
+    auto features = torch::empty({B,N,C}, torch::kFloat32);
+    auto indices = torch::empty({B,N,3}, torch::kInt32);
+    auto weights = torch::empty({B,N,3}, torch::kFloat32);
+    float* features_ptr = features.data_ptr<float>();
+    int* indices_ptr = indices.data_ptr<int>();
+    float* weights_ptr = weights.data_ptr<float>();
+
+    at::parallel_for(0, int64_t(B) * N, 64, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            const int b = i / N;
+            int* idx = indices_ptr + 3 * i;
+            float* w = weights_ptr + 3 * i;
+            internal::KnnHeap heap(idx, w, 3);
+            grids[b].search(dense_ptr + 3 * i, heap);
+            const int count = heap.sort();
+            float sum = 0;
+            for(int j = 0; j < count; ++j) {
+                w[j] = 1.f / (w[j] + 1e-8f);
+                sum += w[j];
+            }
+            for(int j = 0; j < count; ++j)
+                w[j] /= sum;
+            std::fill(idx + count, idx + 3, -1);
+            std::fill(w + count, w + 3, 0.f);
+
+            // idx[j] are global indices in the coarse points until here
+            float* out = features_ptr + i * C;
+            std::fill(out, out + C, 0.f);
+            for(int j = 0; j < count; ++j)
+            {
+                const float* f = coarse_features_ptr + int64_t(idx[j]) * C;
+                const float wj = w[j];
+                for(int c = 0; c < C; ++c)
+                    out[c] += wj * f[c];
+                idx[j] -= b * M;
+            }
+        }
+    });
+
+    if(not batched)
+        return std::make_tuple(features[0], indices[0], weights[0]);
+    return std::make_tuple(features, indices, weights);
+}
+
+torch::Tensor three_interpolate_backward(
+    torch::Tensor indices,
+    torch::Tensor weights,
+    torch::Tensor grad_features,
+    int M)
+{
+    CHECK_CONTIGUOUS(indices);
+    CHECK_CONTIGUOUS(weights);
+    CHECK_CONTIGUOUS(grad_features);
+    const int dim = indices.dim();
+    TORCH_CHECK((dim == 2 or dim == 3) and indices.size(-1) == 3, "indices must have size [N,3] or [B,N,3]");
+    TORCH_CHECK(indices.dtype() == torch::kInt32, "indices must be int");
+    TORCH_CHECK(weights.sizes() == indices.sizes(), "weights must have the size of indices");
+    TORCH_CHECK(grad_features.dim() == dim and grad_features.size(-2) == indices.size(-2), 
+        "grad_features must have size [N,C] or [B,N,C]");
+    TORCH_CHECK(dim == 2 or grad_features.size(0) == indices.size(0), 
+        "indices and grad_features must have the same batch size");
+    TORCH_CHECK(0 <= M, "M must be non-negative");
+    DISPATCH(grad_features.device(), three_interpolate_backward, indices, weights, grad_features, M);
+}
+
+torch::Tensor three_interpolate_backward_cpu(
+    torch::Tensor indices,
+    torch::Tensor weights,
+    torch::Tensor grad_features,
+    int M)
+{
+    CHECK_CPU(indices);
+    CHECK_CPU(weights);
+    CHECK_CPU(grad_features);
+    const bool batched = indices.dim() == 3;
+    const int B = batched ? indices.size(0) : 1;
+    const int N = indices.size(-2);
+    const int C = grad_features.size(-1);
+    const int* indices_ptr = indices.data_ptr<int>();
+    const float* weights_ptr = weights.data_ptr<float>();
+    const float* grad_ptr = grad_features.data_ptr<float>();
+    const int64_t E = 3 * int64_t(B) * N;
+    const int64_t K = int64_t(B) * M;
+    TORCH_CHECK(E < std::numeric_limits<int>::max() and K < std::numeric_limits<int>::max(), 
+        "too many points");
+
+    // (dense point, neighbor) pairs grouped by global coarse point,
+    // missing neighbors (-1) in bucket B*M
+    std::vector<int> keys(E);
+    at::parallel_for(0, E, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t e = begin; e < end; ++e)
+        {
+            const int j = indices_ptr[e];
+            const int b = e / (3 * int64_t(N));
+            keys[e] = j < 0 or M <= j ? K : b * M + j;
+        }
+    });
+    std::vector<int> offsets(K + 2);
+    std::vector<int> order(E);
+    counting_sort(keys.data(), E, K + 1, offsets.data(), order.data());
+
+    auto grad_coarse = torch::empty({B,M,C}, torch::kFloat32);
+    float* grad_coarse_ptr = grad_coarse.data_ptr<float>();
+    at::parallel_for(0, K, 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t m = begin; m < end; ++m)
+        {
+            float* out = grad_coarse_ptr + m * C;
+            std::fill(out, out + C, 0.f);
+            for(int k = offsets[m]; k < offsets[m+1]; ++k)
+            {
+                const int e = order[k];
+                const float w = weights_ptr[e];
+                const float* g = grad_ptr + int64_t(e / 3) * C;
+                for(int c = 0; c < C; ++c)
+                    out[c] += w * g[c];
+            }
+        }
+    });
+
+    if(not batched)
+        return grad_coarse[0];
+    return grad_coarse;
+}
+
+} // namespace torch_points
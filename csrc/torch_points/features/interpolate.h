@@ -0,0 +1,58 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// PointNet++ feature propagation: features of the coarse points interpolated
+// at the dense points from their 3 nearest coarse points, weighted by the
+// inverse squared distance
+//
+// dense_points:    float (N,3) or (B,N,3)
+// coarse_points:   float (M,3) or (B,M,3)
+// coarse_features: float (M,C) or (B,M,C)
+//
+// returns
+//      features: float (N,C) or (B,N,C)
+//      indices:  int (N,3) or (B,N,3):   nearest coarse points sorted by distance,
+//                                        indices in the points of the same sample,
+//                                        -1 if the sample has less than 3 points
+//      weights:  float (N,3) or (B,N,3): normalized weights, 0 for missing points
+//
+// the neighbors are searched in one uniform 3D grid per sample, each output
+// row is accumulated in a single pass vectorized over the channels
+//
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> three_interpolate(
+    torch::Tensor dense_points,
+    torch::Tensor coarse_points,
+    torch::Tensor coarse_features);
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> three_interpolate_cpu(
+    torch::Tensor dense_points,
+    torch::Tensor coarse_points,
+    torch::Tensor coarse_features);
+
+//
+// gradient of the coarse features given the indices and weights returned by
+// three_interpolate and the gradient of the interpolated features
+// grad_features (N,C) or (B,N,C)
+//
+// returns float (M,C) or (B,M,C)
+//
+// the dense points are grouped by coarse point by a counting sort and the
+// contributions are summed in parallel, without atomics
+//
+torch::Tensor three_interpolate_backward(
+    torch::Tensor indices,
+    torch::Tensor weights,
+    torch::Tensor grad_features,
+    int M);
+
+torch::Tensor three_interpolate_backward_cpu(
+    torch::Tensor indices,
+    torch::Tensor weights,
+    torch::Tensor grad_features,
+    int M);
+
+} // namespace torch_points
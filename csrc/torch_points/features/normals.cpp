@@ -0,0 +1,189 @@
+#include <torch_points/features/normals.h>
+#include <torch_points/features/internal/eigen.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+
+namespace torch_points {
+
+namespace {
+
+// moments of a neighborhood, relative to the query point for accuracy
+struct Moments
+{
+    int count = 0;
+    double sum[3] = {0, 0, 0};
+    double sum2[6] = {0, 0, 0, 0, 0, 0}; // xx, xy, xz, yy, yz, zz
+
+    void push(const float* p, const float* q)
+    {
+        const double d[3] = {p[0] - q[0], p[1] - q[1], p[2] - q[2]};
+        ++count;
+        for(int i = 0; i < 3; ++i)
+            sum[i] += d[i];
+        sum2[0] += d[0]*d[0];
+        sum2[1] += d[0]*d[1];
+        sum2[2] += d[0]*d[2];
+        sum2[3] += d[1]*d[1];
+        sum2[4] += d[1]*d[2];
+        sum2[5] += d[2]*d[2];
+    }
+
+    void covariance(double c[6]) const
+    {
+        const double m[3] = {sum[0] / count, sum[1] / count, sum[2] / count};
+        c[0] = sum2[0] / count - m[0]*m[0];
+        c[1] = sum2[1] / count - m[0]*m[1];
+        c[2] = sum2[2] / count - m[0]*m[2];
+        c[3] = sum2[3] / count - m[1]*m[1];
+        c[4] = sum2[4] / count - m[1]*m[2];
+        c[5] = sum2[5] / count - m[2]*m[2];
+    }
+};
+
+void check_neighborhood(int k, float r)
+{
+    TORCH_CHECK(0 < k or 0 < r, "k or r must be positive");
+}
+
+//
+// f(i, moments) is called in parallel for each point i
+//
+template<typename F>
+void for_each_neighborhood(torch::Tensor points, int k, float r, F&& f)
+{
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const auto grids = internal::build_grids(points_ptr, {0, N}, std::max(r, 0.f), std::max(k, 0));
+    const internal::Grid3D& grid = grids[0];
+
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        std::vector<int> idx(std::max(k, 0));
+        std::vector<float> d2(std::max(k, 0));
+        for(int64_t i = begin; i < end; ++i)
+        {
+            const float* q = points_ptr + 3 * i;
+            Moments moments;
+            if(k <= 0)
+            {
+                // unbounded radius neighborhood, accumulated without storing it
+                grid.for_each_in_radius(q, r, [&](int j, float) {
+                    moments.push(points_ptr + 3 * int64_t(j), q);
+                });
+            }
+            else
+            {
+                internal::KnnHeap heap(idx.data(), d2.data(), k, 0 < r ? r * r : INFINITY);
+                grid.search(q, heap);
+                for(int n = 0; n < heap.count; ++n)
+                    moments.push(points_ptr + 3 * int64_t(idx[n]), q);
+            }
+            f(i, moments);
+        }
+    });
+}
+
+} // anonymous namespace
+
+torch::Tensor estimate_normals(
+    torch::Tensor points,
+    int k,
+    float r,
+    torch::optional<torch::Tensor> viewpoint)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    check_neighborhood(k, r);
+    if(viewpoint.has_value())
+        TORCH_CHECK(viewpoint->numel() == 3, "viewpoint must have size [3]");
+    DISPATCH(points.device(), estimate_normals, points, k, r, viewpoint);
+}
+
+torch::Tensor estimate_normals_cpu(
+    torch::Tensor points,
+    int k,
+    float r,
+    torch::optional<torch::Tensor> viewpoint)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    float view[3] = {0, 0, 0};
+    if(viewpoint.has_value()) {
+        const auto viewpoint_float = viewpoint->to(torch::kFloat32).contiguous();
+        std::copy(viewpoint_float.data_ptr<float>(), viewpoint_float.data_ptr<float>() + 3, view);
+    }
+
+    auto normals = torch::empty({N,3}, torch::kFloat32);
+    float* normals_ptr = normals.data_ptr<float>();
+    for_each_neighborhood(points, k, r, [&](int64_t i, const Moments& moments)
+    {
+        float* n = normals_ptr + 3 * i;
+        if(moments.count < 3) {
+            n[0] = n[1] = n[2] = 0;
+            return;
+        }
+        double c[6], e[3], v[3];
+        moments.covariance(c);
+        internal::eigenvalues(c, e);
+        internal::eigenvector(c, e[0], v);
+        if(viewpoint.has_value())
+        {
+            const float* p = points_ptr + 3 * i;
+            const double dot = v[0] * (view[0] - p[0]) + v[1] * (view[1] - p[1]) + v[2] * (view[2] - p[2]);
+            if(dot < 0)
+                for(int d = 0; d < 3; ++d)
+                    v[d] = -v[d];
+        }
+        for(int d = 0; d < 3; ++d)
+            n[d] = v[d];
+    });
+    return normals;
+}
+
+std::pair<torch::Tensor,torch::Tensor> covariance_features(
+    torch::Tensor points,
+    int k,
+    float r)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    check_neighborhood(k, r);
+    DISPATCH(points.device(), covariance_features, points, k, r);
+}
+
+std::pair<torch::Tensor,torch::Tensor> covariance_features_cpu(
+    torch::Tensor points,
+    int k,
+    float r)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    auto eigenvalues = torch::empty({N,3}, torch::kFloat32);
+    auto features = torch::empty({N,4}, torch::kFloat32);
+    float* eigenvalues_ptr = eigenvalues.data_ptr<float>();
+    float* features_ptr = features.data_ptr<float>();
+    for_each_neighborhood(points, k, r, [&](int64_t i, const Moments& moments)
+    {
+        double c[6], e[3];
+        moments.covariance(c);
+        internal::eigenvalues(c, e);
+        // rounding can give tiny negative eigenvalues
+        for(int d = 0; d < 3; ++d)
+            eigenvalues_ptr[3*i+d] = e[d] = std::max(e[d], 0.);
+        float* f = features_ptr + 4 * i;
+        if(e[2] <= 0) {
+            f[0] = f[1] = f[2] = f[3] = 0;
+            return;
+        }
+        f[0] = (e[2] - e[1]) / e[2];
+        f[1] = (e[1] - e[0]) / e[2];
+        f[2] = e[0] / e[2];
+        f[3] = e[0] / (e[0] + e[1] + e[2]);
+    });
+    return std::make_pair(eigenvalues, features);
+}
+
+} // namespace torch_points
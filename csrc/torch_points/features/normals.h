@@ -0,0 +1,57 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// local PCA over the neighborhood of each point
+//
+// neighborhoods:
+//      r <= 0: the k nearest neighbors (including the point itself)
+//      r > 0:  the neighbors within distance r, only the k nearest ones if k > 0
+//
+// neighbors are searched in a uniform 3D grid, the covariance matrix of each
+// neighborhood is decomposed by a closed-form 3x3 symmetric eigen solver,
+// in parallel over the points
+//
+
+//
+// viewpoint: optional float (3): normals are flipped toward the viewpoint
+//
+// returns
+//      normals: float (N,3): eigenvector of the smallest eigenvalue,
+//                            zero if the neighborhood has less than 3 points
+//
+torch::Tensor estimate_normals(
+    torch::Tensor points,
+    int k,
+    float r,
+    torch::optional<torch::Tensor> viewpoint);
+
+torch::Tensor estimate_normals_cpu(
+    torch::Tensor points,
+    int k,
+    float r,
+    torch::optional<torch::Tensor> viewpoint);
+
+//
+// returns
+//      eigenvalues: float (N,3): eigenvalues of the covariance in increasing order l0 <= l1 <= l2
+//      features:    float (N,4): linearity  (l2-l1)/l2
+//                                planarity  (l1-l0)/l2
+//                                scattering l0/l2
+//                                curvature  l0/(l0+l1+l2)
+//                                zero if l2 is zero
+//
+std::pair<torch::Tensor,torch::Tensor> covariance_features(
+    torch::Tensor points,
+    int k,
+    float r);
+
+std::pair<torch::Tensor,torch::Tensor> covariance_features_cpu(
+    torch::Tensor points,
+    int k,
+    float r);
+
+} // namespace torch_points
@@ -0,0 +1,103 @@
+#include <torch_points/filtering/crop.h>
+#include <torch_points/filtering/internal/box.h>
+#include <torch_points/filtering/internal/polygon.h>
+#include <torch_points/common/compact.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+
+namespace torch_points {
+
+namespace {
+
+template<typename F>
+std::pair<torch::Tensor,torch::Tensor> crop(torch::Tensor points, F&& inside)
+{
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    auto mask = torch::empty({N}, torch::kBool);
+    bool* mask_ptr = mask.data_ptr<bool>();
+    at::parallel_for(0, N, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            mask_ptr[i] = inside(points_ptr + 3 * i);
+    });
+    return std::make_pair(mask, mask_to_indices(mask_ptr, N));
+}
+
+} // anonymous namespace
+
+std::pair<torch::Tensor,torch::Tensor> crop_box(
+    torch::Tensor points,
+    torch::Tensor bounds)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    DISPATCH(points.device(), crop_box, points, bounds);
+}
+
+std::pair<torch::Tensor,torch::Tensor> crop_box_cpu(
+    torch::Tensor points,
+    torch::Tensor bounds)
+{
+    CHECK_CPU(points);
+    const internal::CropBox box(bounds);
+    return crop(points, [&](const float* p) {
+        return box.contains(p);
+    });
+}
+
+std::pair<torch::Tensor,torch::Tensor> crop_obb(
+    torch::Tensor points,
+    torch::Tensor center,
+    torch::Tensor rotation,
+    torch::Tensor extent)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    DISPATCH(points.device(), crop_obb, points, center, rotation, extent);
+}
+
+std::pair<torch::Tensor,torch::Tensor> crop_obb_cpu(
+    torch::Tensor points,
+    torch::Tensor center,
+    torch::Tensor rotation,
+    torch::Tensor extent)
+{
+    CHECK_CPU(points);
+    const internal::CropOBB box(center, rotation, extent);
+    return crop(points, [&](const float* p) {
+        return box.contains(p);
+    });
+}
+
+std::pair<torch::Tensor,torch::Tensor> crop_polygon(
+    torch::Tensor points,
+    torch::Tensor polygon,
+    torch::optional<torch::Tensor> rings)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    CHECK_CONTIGUOUS(polygon);
+    TORCH_CHECK(polygon.dim() == 2 and polygon.size(1) == 2 and polygon.dtype() == torch::kFloat32, 
+        "polygon must be a float tensor of size [P,2]");
+    DISPATCH(points.device(), crop_polygon, points, polygon, rings);
+}
+
+std::pair<torch::Tensor,torch::Tensor> crop_polygon_cpu(
+    torch::Tensor points,
+    torch::Tensor polygon,
+    torch::optional<torch::Tensor> rings)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(polygon);
+    const std::vector<int> offsets = check_offsets(rings, polygon.size(0));
+    if(polygon.size(0) == 0)
+        return crop(points, [](const float*) { return false; });
+    const internal::PolygonGrid grid(polygon.data_ptr<float>(), offsets);
+    return crop(points, [&](const float* p) {
+        return grid.contains(p[0], p[1]);
+    });
+}
+
+} // namespace torch_points
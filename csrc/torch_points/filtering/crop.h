@@ -0,0 +1,59 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// crop of 3D points to a region, tested in parallel over the points
+//
+// returns
+//      mask:    bool (N): true for the points inside the region
+//      indices: long (M): indices of the points inside the region
+//
+
+// axis-aligned box, bounds: float (6): xmin/xmax/ymin/ymax/zmin/zmax, bounds included
+std::pair<torch::Tensor,torch::Tensor> crop_box(
+    torch::Tensor points,
+    torch::Tensor bounds);
+
+std::pair<torch::Tensor,torch::Tensor> crop_box_cpu(
+    torch::Tensor points,
+    torch::Tensor bounds);
+
+// oriented box of given center (3), rotation (3,3) whose columns are the axes
+// of the box, and extent (3) the sizes of the box along its axes
+std::pair<torch::Tensor,torch::Tensor> crop_obb(
+    torch::Tensor points,
+    torch::Tensor center,
+    torch::Tensor rotation,
+    torch::Tensor extent);
+
+std::pair<torch::Tensor,torch::Tensor> crop_obb_cpu(
+    torch::Tensor points,
+    torch::Tensor center,
+    torch::Tensor rotation,
+    torch::Tensor extent);
+
+//
+// 2D polygon in x/y, polygon: float (P,2) vertices of one or several rings,
+// rings: optional int (R+1) offsets of the rings, one ring by default
+// rings are closed implicitly, the inside is given by the even-odd rule so
+// holes are rings inside the outer ring
+//
+// the bounding box of the polygon is split in cells with the arithmetic of
+// build_grid2d, the edges are bucketed by row of cells in CSR format and each
+// cell is flagged inside, outside, or crossed by an edge: only the points in
+// crossed cells are tested, by ray casting against the edges of their row
+//
+std::pair<torch::Tensor,torch::Tensor> crop_polygon(
+    torch::Tensor points,
+    torch::Tensor polygon,
+    torch::optional<torch::Tensor> rings);
+
+std::pair<torch::Tensor,torch::Tensor> crop_polygon_cpu(
+    torch::Tensor points,
+    torch::Tensor polygon,
+    torch::optional<torch::Tensor> rings);
+
+} // namespace torch_points
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+namespace internal {
+
+// float copy of a small parameter tensor of n values
+inline std::vector<float> parameter(torch::Tensor t, int n, const char* name)
+{
+    TORCH_CHECK(t.device().is_cpu(), name, " must be a CPU tensor");
+    TORCH_CHECK(t.numel() == n, name, " must have ", n, " values");
+    const auto t_float = t.to(torch::kFloat32).contiguous();
+    const float* ptr = t_float.data_ptr<float>();
+    return std::vector<float>(ptr, ptr + n);
+}
+
+//
+// axis-aligned crop box, bounds are xmin/xmax/ymin/ymax/zmin/zmax, the
+// bounds are inside
+//
+class CropBox
+{
+public:
+    CropBox(torch::Tensor bounds) :
+        m_bounds(parameter(bounds, 6, "bounds"))
+    {
+    }
+
+    bool contains(const float* p) const
+    {
+        const float* b = m_bounds.data();
+        return (b[0] <= p[0]) & (p[0] <= b[1])
+             & (b[2] <= p[1]) & (p[1] <= b[3])
+             & (b[4] <= p[2]) & (p[2] <= b[5]);
+    }
+
+protected:
+    std::vector<float> m_bounds;
+};
+
+//
+// oriented crop box of the given center, rotation (3,3) whose columns are
+// the axes of the box, and extent along these axes, the faces are inside
+//
+class CropOBB
+{
+public:
+    CropOBB(torch::Tensor center, torch::Tensor rotation, torch::Tensor extent) :
+        m_center(parameter(center, 3, "center")),
+        m_rotation(parameter(rotation, 9, "rotation")),
+        m_extent(parameter(extent, 3, "extent"))
+    {
+    }
+
+    bool contains(const float* p) const
+    {
+        const float* c = m_center.data();
+        const float* R = m_rotation.data();
+        const float* e = m_extent.data();
+        // coordinates in the box frame: R^T (p - c)
+        const float d[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+        bool inside = true;
+        for(int k = 0; k < 3; ++k) {
+            const float u = R[k] * d[0] + R[3+k] * d[1] + R[6+k] * d[2];
+            inside &= std::abs(u) <= 0.5f * e[k];
+        }
+        return inside;
+    }
+
+protected:
+    std::vector<float> m_center;
+    std::vector<float> m_rotation;
+    std::vector<float> m_extent;
+};
+
+} // namespace internal
+} // namespace torch_points
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <torch/extension.h>
+#include <torch_points/spatial/internal/cell.h>
+
+#include <array>
+
+namespace torch_points {
+namespace internal {
+
+//
+// edges of a polygon bucketed by row of cells, and cells flagged by their
+// position relative to the polygon
+//
+class PolygonGrid
+{
+public:
+    enum Cell : uint8_t { Outside, Inside, Crossed };
+
+    PolygonGrid(const float* xy, const std::vector<int>& rings)
+    {
+        const int P = rings.back();
+        m_xmin = m_ymin = INFINITY;
+        m_xmax = m_ymax = -INFINITY;
+        for(int i = 0; i < P; ++i) {
+            m_xmin = std::min(m_xmin, xy[2*i]);
+            m_xmax = std::max(m_xmax, xy[2*i]);
+            m_ymin = std::min(m_ymin, xy[2*i+1]);
+            m_ymax = std::max(m_ymax, xy[2*i+1]);
+        }
+        // about 4 cells per edge, square if the polygon is not degenerate
+        const float w = m_xmax - m_xmin;
+        const float h = m_ymax - m_ymin;
+        const float d = std::sqrt(w * h / (4.f * std::max(P, 1)));
+        m_Nx = 0 < d ? std::min(4096, std::max(1, static_cast<int>(std::ceil(w / d)))) : 1;
+        m_Ny = 0 < d ? std::min(4096, std::max(1, static_cast<int>(std::ceil(h / d)))) : 1;
+        m_dx = 0 < w ? w / m_Nx : 1;
+        m_dy = 0 < h ? h / m_Ny : 1;
+
+        // 1. edges of each ring, the last vertex is linked to the first one
+        std::vector<std::array<float,4>> edges;
+        for(size_t r = 0; r + 1 < rings.size(); ++r)
+            for(int i = rings[r]; i < rings[r+1]; ++i) {
+                const int j = i + 1 < rings[r+1] ? i + 1 : rings[r];
+                edges.push_back({xy[2*i], xy[2*i+1], xy[2*j], xy[2*j+1]});
+            }
+
+        // 2. edges in CSR format by row of cells
+        m_rows.assign(m_Ny + 1, 0);
+        for(const auto& e : edges)
+            for(int iy = row(std::min(e[1], e[3])); iy <= row(std::max(e[1], e[3])); ++iy)
+                ++m_rows[iy+1];
+        for(int iy = 0; iy < m_Ny; ++iy)
+            m_rows[iy+1] += m_rows[iy];
+        std::vector<int> pos(m_rows.begin(), m_rows.end() - 1);
+        m_x0.resize(m_rows[m_Ny]);
+        m_y0.resize(m_rows[m_Ny]);
+        m_x1.resize(m_rows[m_Ny]);
+        m_y1.resize(m_rows[m_Ny]);
+        m_cells.assign(int64_t(m_Nx) * m_Ny, Outside);
+        for(const auto& e : edges)
+        {
+            for(int iy = row(std::min(e[1], e[3])); iy <= row(std::max(e[1], e[3])); ++iy)
+            {
+                const int k = pos[iy]++;
+                m_x0[k] = e[0];
+                m_y0[k] = e[1];
+                m_x1[k] = e[2];
+                m_y1[k] = e[3];
+
+                // cells of the row crossed by the edge, one cell of margin
+                const float y_lo = std::max(std::min(e[1], e[3]), m_ymin + iy * m_dy);
+                const float y_hi = std::min(std::max(e[1], e[3]), m_ymin + (iy+1) * m_dy);
+                float x_lo = std::min(e[0], e[2]);
+                float x_hi = std::max(e[0], e[2]);
+                if(e[1] != e[3]) {
+                    const float x_a = e[0] + (y_lo - e[1]) * (e[2] - e[0]) / (e[3] - e[1]);
+                    const float x_b = e[0] + (y_hi - e[1]) * (e[2] - e[0]) / (e[3] - e[1]);
+                    x_lo = std::max(x_lo, std::min(x_a, x_b));
+                    x_hi = std::min(x_hi, std::max(x_a, x_b));
+                }
+                const int ix_lo = std::max(column(x_lo) - 1, 0);
+                const int ix_hi = std::min(column(x_hi) + 1, m_Nx - 1);
+                for(int jy = std::max(iy - 1, 0); jy <= std::min(iy + 1, m_Ny - 1); ++jy)
+                    for(int ix = ix_lo; ix <= ix_hi; ++ix)
+                        m_cells[int64_t(jy) * m_Nx + ix] = Crossed;
+            }
+        }
+
+        // 3. cells not crossed by an edge are inside or outside as their center
+        at::parallel_for(0, m_Ny, 16, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t iy = begin; iy < end; ++iy)
+                for(int ix = 0; ix < m_Nx; ++ix)
+                {
+                    uint8_t& cell = m_cells[iy * m_Nx + ix];
+                    if(cell != Crossed)
+                        cell = ray_cast(m_xmin + (ix + 0.5f) * m_dx, m_ymin + (iy + 0.5f) * m_dy, iy) ? Inside : Outside;
+                }
+        });
+    }
+
+    bool contains(float x, float y) const
+    {
+        if(not (m_xmin <= x and x <= m_xmax and m_ymin <= y and y <= m_ymax))
+            return false;
+        const int iy = row(y);
+        const uint8_t cell = m_cells[int64_t(iy) * m_Nx + column(x)];
+        return cell == Crossed ? ray_cast(x, y, iy) : cell == Inside;
+    }
+
+protected:
+    int row(float y) const
+    {
+        return internal::cell_coord(y, m_ymin, m_dy, m_Ny);
+    }
+
+    int column(float x) const
+    {
+        return internal::cell_coord(x, m_xmin, m_dx, m_Nx);
+    }
+
+    // even-odd number of edges of the row crossing the ray from (x,y) toward +x,
+    // the half-open rule on y counts a vertex on the ray once
+    bool ray_cast(float x, float y, int iy) const
+    {
+        int crossings = 0;
+        for(int k = m_rows[iy]; k < m_rows[iy+1]; ++k)
+        {
+            const bool straddle = (y < m_y0[k]) != (y < m_y1[k]);
+            const float t = (y - m_y0[k]) / (m_y1[k] - m_y0[k]);
+            crossings += straddle & (x < m_x0[k] + t * (m_x1[k] - m_x0[k]));
+        }
+        return crossings & 1;
+    }
+
+protected:
+    float m_xmin, m_xmax, m_ymin, m_ymax;
+    float m_dx, m_dy;
+    int m_Nx, m_Ny;
+    std::vector<int> m_rows;        // (Ny+1) edges of each row
+    std::vector<float> m_x0;        // edges endpoints
+    std::vector<float> m_y0;
+    std::vector<float> m_x1;
+    std::vector<float> m_y1;
+    std::vector<uint8_t> m_cells;   // (Ny,Nx)
+};
+
+} // namespace internal
+} // namespace torch_points
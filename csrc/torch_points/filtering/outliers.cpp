@@ -0,0 +1,116 @@
+#include <torch_points/filtering/outliers.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/compact.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+namespace torch_points {
+
+std::pair<torch::Tensor,torch::Tensor> remove_statistical_outliers(
+    torch::Tensor points,
+    int k,
+    float std_ratio)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < k, "k must be positive");
+    DISPATCH(points.device(), remove_statistical_outliers, points, k, std_ratio);
+}
+
+std::pair<torch::Tensor,torch::Tensor> remove_statistical_outliers_cpu(
+    torch::Tensor points,
+    int k,
+    float std_ratio)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const auto grids = internal::build_grids(points_ptr, {0, N}, 0, k);
+    const internal::Grid3D& grid = grids[0];
+
+    // 1. mean distance to the k nearest neighbors, the point itself excluded
+    std::vector<float> distances(N);
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        std::vector<int> idx(k + 1);
+        std::vector<float> d2(k + 1);
+        for(int64_t i = begin; i < end; ++i)
+        {
+            internal::KnnHeap heap(idx.data(), d2.data(), k + 1);
+            grid.search(points_ptr + 3 * i, heap);
+            double sum = 0;
+            int count = 0;
+            for(int j = 0; j < heap.count and count < k; ++j) {
+                if(idx[j] == i)
+                    continue;
+                sum += std::sqrt(d2[j]);
+                ++count;
+            }
+            distances[i] = count == 0 ? 0 : sum / count;
+        }
+    });
+
+    // 2. global statistics
+    using Moments = std::pair<double,double>;
+    const Moments moments = at::parallel_reduce(0, N, 16384, Moments(0, 0),
+        [&](int64_t begin, int64_t end, Moments m) -> Moments {
+            for(int64_t i = begin; i < end; ++i) {
+                m.first += distances[i];
+                m.second += double(distances[i]) * distances[i];
+            }
+            return m;
+        },
+        [](const Moments& a, const Moments& b) -> Moments {
+            return {a.first + b.first, a.second + b.second};
+        });
+    const double mean = N == 0 ? 0 : moments.first / N;
+    const double variance = N < 2 ? 0 : std::max(0., (moments.second - N * mean * mean) / (N - 1));
+    const double threshold = mean + std_ratio * std::sqrt(variance);
+
+    // 3. mask
+    auto mask = torch::empty({N}, torch::kBool);
+    bool* mask_ptr = mask.data_ptr<bool>();
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            mask_ptr[i] = distances[i] <= threshold;
+    });
+    return std::make_pair(mask, mask_to_indices(mask_ptr, N));
+}
+
+std::pair<torch::Tensor,torch::Tensor> remove_radius_outliers(
+    torch::Tensor points,
+    float r,
+    int min_neighbors)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 <= r, "r must be non-negative");
+    TORCH_CHECK(0 <= min_neighbors, "min_neighbors must be non-negative");
+    DISPATCH(points.device(), remove_radius_outliers, points, r, min_neighbors);
+}
+
+std::pair<torch::Tensor,torch::Tensor> remove_radius_outliers_cpu(
+    torch::Tensor points,
+    float r,
+    int min_neighbors)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const auto grids = internal::build_grids(points_ptr, {0, N}, r);
+    const internal::Grid3D& grid = grids[0];
+
+    // the search stops as soon as min_neighbors neighbors (and the point) are found within r
+    const int K = min_neighbors + 1;
+    auto mask = torch::empty({N}, torch::kBool);
+    bool* mask_ptr = mask.data_ptr<bool>();
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            mask_ptr[i] = K <= grid.count_in_radius(points_ptr + 3 * i, r, K);
+    });
+    return std::make_pair(mask, mask_to_indices(mask_ptr, N));
+}
+
+} // namespace torch_points
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// outlier removal, neighbors are searched in a uniform 3D grid in parallel
+// over the points, no (N,k) neighbors tensor is built
+//
+// returns
+//      mask:    bool (N): true for the points that are kept
+//      indices: long (M): indices of the points that are kept
+//
+
+// a point is removed if the mean distance to its k nearest neighbors is larger
+// than mean + std_ratio * std over all the points
+std::pair<torch::Tensor,torch::Tensor> remove_statistical_outliers(
+    torch::Tensor points,
+    int k,
+    float std_ratio);
+
+std::pair<torch::Tensor,torch::Tensor> remove_statistical_outliers_cpu(
+    torch::Tensor points,
+    int k,
+    float std_ratio);
+
+// a point is removed if it has less than min_neighbors other points within distance r
+std::pair<torch::Tensor,torch::Tensor> remove_radius_outliers(
+    torch::Tensor points,
+    float r,
+    int min_neighbors);
+
+std::pair<torch::Tensor,torch::Tensor> remove_radius_outliers_cpu(
+    torch::Tensor points,
+    float r,
+    int min_neighbors);
+
+} // namespace torch_points
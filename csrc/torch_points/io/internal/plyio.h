@@ -5,6 +5,7 @@
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <functional>
 
 #ifndef PLYIO_ASSERT
     #include <assert.h>
@@ -152,6 +153,9 @@ struct RElement
     std::string name;
     int count;
     std::vector<RProperty> properties;
+    // set by user using PLYReader::read_chunks()
+    int chunk_size = 0;
+    std::function<void(int,int)> on_chunk;
 };
 
 // PLYReader -------------------------------------------------------------------
@@ -168,6 +172,10 @@ public:
     inline bool read_body(const std::string& filename);
     inline bool read_body(std::istream& is);
 
+    // the properties of the element are written at their index in the current
+    // chunk of chunk_size elements, on_chunk(begin,end) is called after each chunk
+    inline void read_chunks(const std::string& element_name, int chunk_size, std::function<void(int,int)> on_chunk);
+
     // Internal reading --------------------------------------------------------
 protected:
     inline bool read_body_ascii(std::istream& is);
@@ -731,6 +739,13 @@ bool PLYReader::read_body(std::istream& is)
     }
 }
 
+void PLYReader::read_chunks(const std::string& element_name, int chunk_size, std::function<void(int,int)> on_chunk)
+{
+    RElement& elem = this->element(element_name);
+    elem.chunk_size = chunk_size;
+    elem.on_chunk = std::move(on_chunk);
+}
+
 // Internal reading ------------------------------------------------------------
 
 bool PLYReader::read_body_ascii(std::istream& is)
@@ -752,6 +767,7 @@ bool PLYReader::read_body_ascii(std::istream& is)
         RElement& element = m_elements[idx_element];
         for(int i = 0; i < element.count; ++i)
         {
+            const int k = element.chunk_size > 0 ? i % element.chunk_size : i;
             for(size_t idx_property = 0; idx_property < element.properties.size(); ++idx_property)
             {
                 RProperty& prop = element.properties[idx_property];
@@ -778,14 +794,14 @@ bool PLYReader::read_body_ascii(std::istream& is)
 
                     switch (prop.dtype())
                     {
-                    case type_char:   for(int j=0; j<size; ++j) {is >> tmp0; val0 = tmp0; if(not prop.ignore()){prop.set_value(i,j,val0);}} break;
-                    case type_uchar:  for(int j=0; j<size; ++j) {is >> tmp1; val1 = tmp1; if(not prop.ignore()){prop.set_value(i,j,val1);}} break;
-                    case type_short:  for(int j=0; j<size; ++j) {is >> val2;              if(not prop.ignore()){prop.set_value(i,j,val2);}} break;
-                    case type_ushort: for(int j=0; j<size; ++j) {is >> val3;              if(not prop.ignore()){prop.set_value(i,j,val3);}} break;
-                    case type_int:    for(int j=0; j<size; ++j) {is >> val4;              if(not prop.ignore()){prop.set_value(i,j,val4);}} break;
-                    case type_uint:   for(int j=0; j<size; ++j) {is >> val5;              if(not prop.ignore()){prop.set_value(i,j,val5);}} break;
-                    case type_float:  for(int j=0; j<size; ++j) {is >> val6;              if(not prop.ignore()){prop.set_value(i,j,val6);}} break;
-                    case type_double: for(int j=0; j<size; ++j) {is >> val7;              if(not prop.ignore()){prop.set_value(i,j,val7);}} break;
+                    case type_char:   for(int j=0; j<size; ++j) {is >> tmp0; val0 = tmp0; if(not prop.ignore()){prop.set_value(k,j,val0);}} break;
+                    case type_uchar:  for(int j=0; j<size; ++j) {is >> tmp1; val1 = tmp1; if(not prop.ignore()){prop.set_value(k,j,val1);}} break;
+                    case type_short:  for(int j=0; j<size; ++j) {is >> val2;              if(not prop.ignore()){prop.set_value(k,j,val2);}} break;
+                    case type_ushort: for(int j=0; j<size; ++j) {is >> val3;              if(not prop.ignore()){prop.set_value(k,j,val3);}} break;
+                    case type_int:    for(int j=0; j<size; ++j) {is >> val4;              if(not prop.ignore()){prop.set_value(k,j,val4);}} break;
+                    case type_uint:   for(int j=0; j<size; ++j) {is >> val5;              if(not prop.ignore()){prop.set_value(k,j,val5);}} break;
+                    case type_float:  for(int j=0; j<size; ++j) {is >> val6;              if(not prop.ignore()){prop.set_value(k,j,val6);}} break;
+                    case type_double: for(int j=0; j<size; ++j) {is >> val7;              if(not prop.ignore()){prop.set_value(k,j,val7);}} break;
                     default:          PLYIO_ASSERT(false);
                     }
                 }
@@ -793,18 +809,20 @@ bool PLYReader::read_body_ascii(std::istream& is)
                 {
                     switch (prop.dtype())
                     {
-                    case type_char:   is >> tmp0; val0 = tmp0; if(not prop.ignore()){prop.set_value(i, val0);} break;
-                    case type_uchar:  is >> tmp1; val1 = tmp1; if(not prop.ignore()){prop.set_value(i, val1);} break;
-                    case type_short:  is >> val2;              if(not prop.ignore()){prop.set_value(i, val2);} break;
-                    case type_ushort: is >> val3;              if(not prop.ignore()){prop.set_value(i, val3);} break;
-                    case type_int:    is >> val4;              if(not prop.ignore()){prop.set_value(i, val4);} break;
-                    case type_uint:   is >> val5;              if(not prop.ignore()){prop.set_value(i, val5);} break;
-                    case type_float:  is >> val6;              if(not prop.ignore()){prop.set_value(i, val6);} break;
-                    case type_double: is >> val7;              if(not prop.ignore()){prop.set_value(i, val7);} break;
+                    case type_char:   is >> tmp0; val0 = tmp0; if(not prop.ignore()){prop.set_value(k, val0);} break;
+                    case type_uchar:  is >> tmp1; val1 = tmp1; if(not prop.ignore()){prop.set_value(k, val1);} break;
+                    case type_short:  is >> val2;              if(not prop.ignore()){prop.set_value(k, val2);} break;
+                    case type_ushort: is >> val3;              if(not prop.ignore()){prop.set_value(k, val3);} break;
+                    case type_int:    is >> val4;              if(not prop.ignore()){prop.set_value(k, val4);} break;
+                    case type_uint:   is >> val5;              if(not prop.ignore()){prop.set_value(k, val5);} break;
+                    case type_float:  is >> val6;              if(not prop.ignore()){prop.set_value(k, val6);} break;
+                    case type_double: is >> val7;              if(not prop.ignore()){prop.set_value(k, val7);} break;
                     default:          PLYIO_ASSERT(false);
                     }
                 }
             }
+            if(element.chunk_size > 0 and (k + 1 == element.chunk_size or i + 1 == element.count))
+                element.on_chunk(i - k, i + 1);
         }
     }
     return true;
@@ -829,6 +847,7 @@ bool PLYReader::read_body_binary(std::istream& is)
         RElement& element = m_elements[idx_element];
         for(int i = 0; i < element.count; ++i)
         {
+            const int k = element.chunk_size > 0 ? i % element.chunk_size : i;
             for(size_t idx_property = 0; idx_property < element.properties.size(); ++idx_property)
             {
                 RProperty& prop = element.properties[idx_property];
@@ -855,14 +874,14 @@ bool PLYReader::read_body_binary(std::istream& is)
 
                     switch (prop.dtype())
                     {
-                    case type_char:       for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val0), sizeof(char_t));   if(not prop.ignore()){prop.set_value(i,j,val0);}} break;
-                    case type_uchar:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val1), sizeof(uchar_t));  if(not prop.ignore()){prop.set_value(i,j,val1);}} break;
-                    case type_short:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val2), sizeof(short_t));  if(not prop.ignore()){prop.set_value(i,j,val2);}} break;
-                    case type_ushort:     for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val3), sizeof(ushort_t)); if(not prop.ignore()){prop.set_value(i,j,val3);}} break;
-                    case type_int:        for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val4), sizeof(int_t));    if(not prop.ignore()){prop.set_value(i,j,val4);}} break;
-                    case type_uint:       for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val5), sizeof(uint_t));   if(not prop.ignore()){prop.set_value(i,j,val5);}} break;
-                    case type_float:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val6), sizeof(float_t));  if(not prop.ignore()){prop.set_value(i,j,val6);}} break;
-                    case type_double:     for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val7), sizeof(double_t)); if(not prop.ignore()){prop.set_value(i,j,val7);}} break;
+                    case type_char:       for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val0), sizeof(char_t));   if(not prop.ignore()){prop.set_value(k,j,val0);}} break;
+                    case type_uchar:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val1), sizeof(uchar_t));  if(not prop.ignore()){prop.set_value(k,j,val1);}} break;
+                    case type_short:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val2), sizeof(short_t));  if(not prop.ignore()){prop.set_value(k,j,val2);}} break;
+                    case type_ushort:     for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val3), sizeof(ushort_t)); if(not prop.ignore()){prop.set_value(k,j,val3);}} break;
+                    case type_int:        for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val4), sizeof(int_t));    if(not prop.ignore()){prop.set_value(k,j,val4);}} break;
+                    case type_uint:       for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val5), sizeof(uint_t));   if(not prop.ignore()){prop.set_value(k,j,val5);}} break;
+                    case type_float:      for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val6), sizeof(float_t));  if(not prop.ignore()){prop.set_value(k,j,val6);}} break;
+                    case type_double:     for(int j=0; j<size; ++j) {is.read(reinterpret_cast<char*>(&val7), sizeof(double_t)); if(not prop.ignore()){prop.set_value(k,j,val7);}} break;
                     default:              PLYIO_ASSERT(false);
                     }
                 }
@@ -870,18 +889,20 @@ bool PLYReader::read_body_binary(std::istream& is)
                 {
                     switch (prop.dtype())
                     {
-                    case type_char:       is.read(reinterpret_cast<char*>(&val0), sizeof(char_t));   if(not prop.ignore()){prop.set_value(i,val0);} break;
-                    case type_uchar:      is.read(reinterpret_cast<char*>(&val1), sizeof(uchar_t));  if(not prop.ignore()){prop.set_value(i,val1);} break;
-                    case type_short:      is.read(reinterpret_cast<char*>(&val2), sizeof(short_t));  if(not prop.ignore()){prop.set_value(i,val2);} break;
-                    case type_ushort:     is.read(reinterpret_cast<char*>(&val3), sizeof(ushort_t)); if(not prop.ignore()){prop.set_value(i,val3);} break;
-                    case type_int:        is.read(reinterpret_cast<char*>(&val4), sizeof(int_t));    if(not prop.ignore()){prop.set_value(i,val4);} break;
-                    case type_uint:       is.read(reinterpret_cast<char*>(&val5), sizeof(uint_t));   if(not prop.ignore()){prop.set_value(i,val5);} break;
-                    case type_float:      is.read(reinterpret_cast<char*>(&val6), sizeof(float_t));  if(not prop.ignore()){prop.set_value(i,val6);} break;
-                    case type_double:     is.read(reinterpret_cast<char*>(&val7), sizeof(double_t)); if(not prop.ignore()){prop.set_value(i,val7);} break;
+                    case type_char:       is.read(reinterpret_cast<char*>(&val0), sizeof(char_t));   if(not prop.ignore()){prop.set_value(k,val0);} break;
+                    case type_uchar:      is.read(reinterpret_cast<char*>(&val1), sizeof(uchar_t));  if(not prop.ignore()){prop.set_value(k,val1);} break;
+                    case type_short:      is.read(reinterpret_cast<char*>(&val2), sizeof(short_t));  if(not prop.ignore()){prop.set_value(k,val2);} break;
+                    case type_ushort:     is.read(reinterpret_cast<char*>(&val3), sizeof(ushort_t)); if(not prop.ignore()){prop.set_value(k,val3);} break;
+                    case type_int:        is.read(reinterpret_cast<char*>(&val4), sizeof(int_t));    if(not prop.ignore()){prop.set_value(k,val4);} break;
+                    case type_uint:       is.read(reinterpret_cast<char*>(&val5), sizeof(uint_t));   if(not prop.ignore()){prop.set_value(k,val5);} break;
+                    case type_float:      is.read(reinterpret_cast<char*>(&val6), sizeof(float_t));  if(not prop.ignore()){prop.set_value(k,val6);} break;
+                    case type_double:     is.read(reinterpret_cast<char*>(&val7), sizeof(double_t)); if(not prop.ignore()){prop.set_value(k,val7);} break;
                     default:              PLYIO_ASSERT(false);
                     }
                 }
             }
+            if(element.chunk_size > 0 and (k + 1 == element.chunk_size or i + 1 == element.count))
+                element.on_chunk(i - k, i + 1);
         }
     }
     return true;
@@ -29,6 +29,14 @@ void write_ply_data(
 namespace internal {
 std::optional<torch::ScalarType> get_torch_dtype(plyio::Type ply_dtype);
 plyio::Type get_ply_type(caffe2::TypeMeta torch_dtype);
+
+// opens path in fs and reads its header with reader, checks that the vertex
+// element has x/y/z properties of the same supported dtype and returns it,
+// warns and returns None otherwise
+std::optional<torch::ScalarType> read_xyz_header(
+    const std::string& path,
+    std::ifstream& fs,
+    plyio::PLYReader& reader);
 } // namespace internal
 
 } // namespace torch_points
\ No newline at end of file
@@ -6,50 +6,12 @@ namespace torch_points {
 torch::optional<torch::Tensor> read_ply(const std::string& path)
 {
     plyio::PLYReader reader;
-    std::ifstream fs(path);
-    if(not fs.is_open()) {
-        TORCH_WARN("Failed to open input PLY file '", path, "'");
+    std::ifstream fs;
+    const auto torch_dtype0 = internal::read_xyz_header(path, fs, reader);
+    if(not torch_dtype0.has_value())
         return {};
-    }
-    reader.read_header(fs);
-    if(reader.has_error()) {
-        for(const std::string& err : reader.errors())
-            TORCH_WARN(err);
-        return {};
-    }
-    if(reader.has_warning()) {
-        for(const std::string& w : reader.warnings())
-            TORCH_WARN(w);
-    }
-    if(not reader.has_element("vertex")) {
-        TORCH_WARN("PLY element 'vertex' not found");
-        return {};
-    }
-    if(not reader.has_property("vertex", "x")) {
-        TORCH_WARN("PLY property 'x' not found");
-        return {};
-    }
-    if(not reader.has_property("vertex", "y")) {
-        TORCH_WARN("PLY property 'y' not found");
-        return {};
-    }
-    if(not reader.has_property("vertex", "z")) {
-        TORCH_WARN("PLY property 'z' not found");
-        return {};
-    }
     const auto ply_dtype_x = reader.property("vertex", "x").dtype();
-    const auto ply_dtype_y = reader.property("vertex", "y").dtype();
-    const auto ply_dtype_z = reader.property("vertex", "z").dtype();
-    if(ply_dtype_x != ply_dtype_y or ply_dtype_x != ply_dtype_z or ply_dtype_y != ply_dtype_z) {
-        TORCH_WARN("PLY properties 'x', 'y' and 'z' dtype mismatched: ", ply_dtype_x, " ", ply_dtype_y, " ", ply_dtype_z);
-        return {};
-    }
     const int vertex_count = reader.element_count("vertex");
-    const auto torch_dtype0 = internal::get_torch_dtype(ply_dtype_x);
-    if(not torch_dtype0.has_value()) {
-        TORCH_WARN("dtype ", plyio::internal::to_string(ply_dtype_x), " not supported");
-        return {};
-    }
     const auto torch_dtype = torch_dtype0.value();
     const int size = plyio::internal::size_of(ply_dtype_x);
     const int stride = 3 * size;
@@ -0,0 +1,182 @@
+#include <torch_points/metrics/chamfer.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+
+namespace torch_points {
+
+namespace {
+
+// nearest point of targets for each query, queries and targets split by their offsets
+void nearest(
+    const float* queries,
+    const std::vector<int>& query_offsets,
+    const float* targets,
+    const std::vector<int>& target_offsets,
+    float* dist,
+    int* idx)
+{
+    const auto grids = internal::build_grids(targets, target_offsets, 0);
+    const std::vector<int> sample = offsets_to_batch(query_offsets);
+    at::parallel_for(0, query_offsets.back(), 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            internal::KnnHeap heap(idx + i, dist + i, 1);
+            grids[sample[i]].search(queries + 3 * i, heap);
+            if(heap.count == 0) {
+                idx[i] = -1;
+                dist[i] = INFINITY;
+            }
+        }
+    });
+}
+
+//
+// gradient of sum_i g[i] * |q[i] - t[idx[i]]|^2
+//      with respect to q: grad_q[i] = 2 g[i] (q[i] - t[idx[i]])
+//      with respect to t: grad_t[j] = sum over i with idx[i] = j of -2 g[i] (q[i] - t[j])
+// grad_q is written, grad_t is accumulated
+//
+void backward(
+    const float* q,
+    const float* t,
+    const int* idx,
+    const float* g,
+    int N,
+    int M,
+    float* grad_q,
+    float* grad_t)
+{
+    // queries grouped by nearest target, queries without target in bucket M
+    std::vector<int> keys(N);
+    at::parallel_for(0, N, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            const int j = idx[i];
+            keys[i] = j < 0 ? M : j;
+            for(int d = 0; d < 3; ++d)
+                grad_q[3*i+d] = j < 0 ? 0 : 2 * g[i] * (q[3*i+d] - t[3*j+d]);
+        }
+    });
+    std::vector<int> offsets(M + 2);
+    std::vector<int> order(N);
+    counting_sort(keys.data(), N, M + 1, offsets.data(), order.data());
+    at::parallel_for(0, M, 1024, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t j = begin; j < end; ++j)
+            for(int k = offsets[j]; k < offsets[j+1]; ++k)
+                for(int d = 0; d < 3; ++d)
+                    grad_t[3*j+d] -= grad_q[3*order[k]+d];
+    });
+}
+
+} // anonymous namespace
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor,torch::Tensor> chamfer_distance(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::optional<torch::Tensor> a_offsets,
+    torch::optional<torch::Tensor> b_offsets)
+{
+    CHECK_POINTS(a);
+    CHECK_POINTS(b);
+    CHECK_CONTIGUOUS(a);
+    CHECK_CONTIGUOUS(b);
+    TORCH_CHECK(a_offsets.has_value() == b_offsets.has_value(), 
+        "a_offsets and b_offsets must be both given or both None");
+    DISPATCH(a.device(), chamfer_distance, a, b, a_offsets, b_offsets);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor,torch::Tensor> chamfer_distance_cpu(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::optional<torch::Tensor> a_offsets,
+    torch::optional<torch::Tensor> b_offsets)
+{
+    CHECK_CPU(a);
+    CHECK_CPU(b);
+    const int N = a.size(0);
+    const int M = b.size(0);
+    const std::vector<int> offsets_a = check_offsets(a_offsets, N);
+    const std::vector<int> offsets_b = check_offsets(b_offsets, M);
+    TORCH_CHECK(offsets_a.size() == offsets_b.size(), "a and b must have the same number of samples");
+
+    auto dist_a = torch::empty({N}, torch::kFloat32);
+    auto idx_a = torch::empty({N}, torch::kInt32);
+    auto dist_b = torch::empty({M}, torch::kFloat32);
+    auto idx_b = torch::empty({M}, torch::kInt32);
+    nearest(a.data_ptr<float>(), offsets_a, b.data_ptr<float>(), offsets_b, 
+        dist_a.data_ptr<float>(), idx_a.data_ptr<int>());
+    nearest(b.data_ptr<float>(), offsets_b, a.data_ptr<float>(), offsets_a, 
+        dist_b.data_ptr<float>(), idx_b.data_ptr<int>());
+    return std::make_tuple(dist_a, idx_a, dist_b, idx_b);
+}
+
+std::pair<torch::Tensor,torch::Tensor> chamfer_distance_backward(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::Tensor idx_a,
+    torch::Tensor idx_b,
+    torch::Tensor grad_dist_a,
+    torch::Tensor grad_dist_b)
+{
+    CHECK_POINTS(a);
+    CHECK_POINTS(b);
+    CHECK_CONTIGUOUS(a);
+    CHECK_CONTIGUOUS(b);
+    CHECK_CONTIGUOUS(idx_a);
+    CHECK_CONTIGUOUS(idx_b);
+    CHECK_CONTIGUOUS(grad_dist_a);
+    CHECK_CONTIGUOUS(grad_dist_b);
+    TORCH_CHECK(idx_a.numel() == a.size(0) and grad_dist_a.numel() == a.size(0), 
+        "idx_a and grad_dist_a must have size [N]");
+    TORCH_CHECK(idx_b.numel() == b.size(0) and grad_dist_b.numel() == b.size(0), 
+        "idx_b and grad_dist_b must have size [M]");
+    DISPATCH(a.device(), chamfer_distance_backward, 
+        a, b, idx_a, idx_b, grad_dist_a, grad_dist_b);
+}
+
+std::pair<torch::Tensor,torch::Tensor> chamfer_distance_backward_cpu(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::Tensor idx_a,
+    torch::Tensor idx_b,
+    torch::Tensor grad_dist_a,
+    torch::Tensor grad_dist_b)
+{
+    CHECK_CPU(a);
+    CHECK_CPU(b);
+    const int N = a.size(0);
+    const int M = b.size(0);
+    const float* a_ptr = a.data_ptr<float>();
+    const float* b_ptr = b.data_ptr<float>();
+
+    auto grad_a = torch::empty({N,3}, torch::kFloat32);
+    auto grad_b = torch::empty({M,3}, torch::kFloat32);
+    std::vector<float> grad_a_from_b(3 * int64_t(N), 0.f);
+    std::vector<float> grad_b_from_a(3 * int64_t(M), 0.f);
+    backward(a_ptr, b_ptr, idx_a.data_ptr<int>(), grad_dist_a.data_ptr<float>(), N, M, 
+        grad_a.data_ptr<float>(), grad_b_from_a.data());
+    backward(b_ptr, a_ptr, idx_b.data_ptr<int>(), grad_dist_b.data_ptr<float>(), M, N, 
+        grad_b.data_ptr<float>(), grad_a_from_b.data());
+
+    float* grad_a_ptr = grad_a.data_ptr<float>();
+    float* grad_b_ptr = grad_b.data_ptr<float>();
+    at::parallel_for(0, 3 * int64_t(N), 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            grad_a_ptr[i] += grad_a_from_b[i];
+    });
+    at::parallel_for(0, 3 * int64_t(M), 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            grad_b_ptr[i] += grad_b_from_a[i];
+    });
+    return std::make_pair(grad_a, grad_b);
+}
+
+} // namespace torch_points
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// nearest neighbors between two batches of point clouds
+//
+// a:         float (N,3)
+// b:         float (M,3)
+// a_offsets: optional int (B+1): points a_offsets[s]:a_offsets[s+1] are the sample s of a
+// b_offsets: optional int (B+1): same for b
+//
+// returns
+//      dist_a: float (N): squared distance from each point of a to the nearest point
+//                         of b in the same sample, inf if the sample of b is empty
+//      idx_a:  int (N):   index in b of the nearest point, -1 if none
+//      dist_b: float (M): same from b to a
+//      idx_b:  int (M):   index in a of the nearest point, -1 if none
+//
+// neighbors are searched in one uniform 3D grid per sample, in parallel over the points
+//
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor,torch::Tensor> chamfer_distance(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::optional<torch::Tensor> a_offsets,
+    torch::optional<torch::Tensor> b_offsets);
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor,torch::Tensor> chamfer_distance_cpu(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::optional<torch::Tensor> a_offsets,
+    torch::optional<torch::Tensor> b_offsets);
+
+//
+// gradients of the squared distances given their gradients grad_dist_a (N) and grad_dist_b (M)
+//
+// returns
+//      grad_a: float (N,3)
+//      grad_b: float (M,3)
+//
+// the contributions to a point from the points that have it as nearest neighbor
+// are grouped by a counting sort and summed in parallel, without atomics
+//
+std::pair<torch::Tensor,torch::Tensor> chamfer_distance_backward(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::Tensor idx_a,
+    torch::Tensor idx_b,
+    torch::Tensor grad_dist_a,
+    torch::Tensor grad_dist_b);
+
+std::pair<torch::Tensor,torch::Tensor> chamfer_distance_backward_cpu(
+    torch::Tensor a,
+    torch::Tensor b,
+    torch::Tensor idx_a,
+    torch::Tensor idx_b,
+    torch::Tensor grad_dist_a,
+    torch::Tensor grad_dist_b);
+
+} // namespace torch_points
@@ -0,0 +1,381 @@
+#include <torch_points/pipeline/pipeline.h>
+#include <torch_points/filtering/internal/box.h>
+#include <torch_points/filtering/internal/polygon.h>
+#include <torch_points/filtering/outliers.h>
+#include <torch_points/sampling/voxel.h>
+#include <torch_points/spatial/grid2D.h>
+#include <torch_points/io/ply.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+#include <torch_points/common/gather.h>
+#include <torch_points/common/parallel.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+
+namespace torch_points {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// keeps the points of xyz[0:n] for which inside(p) is true, in order
+template<typename F>
+int compact(float* xyz, int n, F&& inside)
+{
+    int m = 0;
+    for(int i = 0; i < n; ++i)
+    {
+        const float* p = xyz + 3 * i;
+        if(inside(p)) {
+            const float x = p[0], y = p[1], z = p[2];
+            xyz[3*m+0] = x;
+            xyz[3*m+1] = y;
+            xyz[3*m+2] = z;
+            ++m;
+        }
+    }
+    return m;
+}
+
+// p <- A p + t, m is row major (3,4)
+int affine(float* xyz, int n, const float* m)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        float* p = xyz + 3 * i;
+        const float x = p[0], y = p[1], z = p[2];
+        for(int d = 0; d < 3; ++d)
+            p[d] = m[4*d] * x + m[4*d+1] * y + m[4*d+2] * z + m[4*d+3];
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+Pipeline::Pipeline(int chunk_size) :
+    m_chunk_size(chunk_size),
+    m_stages(),
+    m_grid(false),
+    m_cell_size(0),
+    m_points_per_cell(0),
+    m_sort_z(false),
+    m_times(),
+    m_read_time(-1)
+{
+    TORCH_CHECK(0 < chunk_size, "chunk_size must be positive");
+}
+
+void Pipeline::add(Stage stage)
+{
+    TORCH_CHECK(not m_grid, "grid2d must be the last stage");
+    m_stages.push_back(std::move(stage));
+    m_times.clear();
+}
+
+// Streaming stages ------------------------------------------------------------
+
+void Pipeline::crop_box(torch::Tensor bounds)
+{
+    const internal::CropBox box(bounds);
+    add({"crop_box", nullptr, [box](float* xyz, int n) {
+        return compact(xyz, n, [&](const float* p) {
+            return box.contains(p);
+        });
+    }});
+}
+
+void Pipeline::crop_obb(torch::Tensor center, torch::Tensor rotation, torch::Tensor extent)
+{
+    const internal::CropOBB box(center, rotation, extent);
+    add({"crop_obb", nullptr, [box](float* xyz, int n) {
+        return compact(xyz, n, [&](const float* p) {
+            return box.contains(p);
+        });
+    }});
+}
+
+void Pipeline::crop_polygon(torch::Tensor polygon, torch::optional<torch::Tensor> rings)
+{
+    CHECK_CPU(polygon);
+    CHECK_CONTIGUOUS(polygon);
+    TORCH_CHECK(polygon.dim() == 2 and polygon.size(1) == 2 and polygon.dtype() == torch::kFloat32,
+        "polygon must be a float tensor of size [P,2]");
+    const std::vector<int> offsets = check_offsets(rings, polygon.size(0));
+    if(polygon.size(0) == 0) {
+        add({"crop_polygon", nullptr, [](float*, int) { return 0; }});
+        return;
+    }
+    const auto grid = std::make_shared<const internal::PolygonGrid>(polygon.data_ptr<float>(), offsets);
+    add({"crop_polygon", nullptr, [grid](float* xyz, int n) {
+        return compact(xyz, n, [&](const float* p) {
+            return grid->contains(p[0], p[1]);
+        });
+    }});
+}
+
+void Pipeline::transform(torch::Tensor matrix)
+{
+    const std::vector<float> m = internal::parameter(matrix, 16, "matrix");
+    add({"transform", nullptr, [m](float* xyz, int n) {
+        return affine(xyz, n, m.data());
+    }});
+}
+
+// Whole cloud stages ----------------------------------------------------------
+
+void Pipeline::voxel_downsample(float voxel_size, const std::string& mode)
+{
+    TORCH_CHECK(0 < voxel_size, "voxel_size must be positive");
+    TORCH_CHECK(mode == "mean" or mode == "first" or mode == "nearest",
+        "mode must be 'mean', 'first' or 'nearest'");
+    add({"voxel_downsample", [voxel_size,mode](torch::Tensor points) {
+        return std::get<0>(torch_points::voxel_downsample(points, torch::nullopt, voxel_size, mode));
+    }, nullptr});
+}
+
+void Pipeline::remove_statistical_outliers(int k, float std_ratio)
+{
+    TORCH_CHECK(0 < k, "k must be positive");
+    add({"remove_statistical_outliers", [k,std_ratio](torch::Tensor points) {
+        const auto indices = torch_points::remove_statistical_outliers(points, k, std_ratio).second;
+        return gather_rows(points, indices.data_ptr<int64_t>(), indices.size(0));
+    }, nullptr});
+}
+
+void Pipeline::remove_radius_outliers(float r, int min_neighbors)
+{
+    TORCH_CHECK(0 <= r, "r must be non-negative");
+    add({"remove_radius_outliers", [r,min_neighbors](torch::Tensor points) {
+        const auto indices = torch_points::remove_radius_outliers(points, r, min_neighbors).second;
+        return gather_rows(points, indices.data_ptr<int64_t>(), indices.size(0));
+    }, nullptr});
+}
+
+void Pipeline::normalize(bool scale)
+{
+    // affine (3,4) of the last run, set by the cloud operation
+    const auto m = std::make_shared<std::array<float,12>>();
+    add({"normalize", [m,scale](torch::Tensor points) {
+        // centroid and radius summed over fixed chunks, so the result does not
+        // depend on the number of threads
+        const int N = points.size(0);
+        const float* points_ptr = points.data_ptr<float>();
+        const int chunk = 4096;
+        const int chunks = (N + chunk - 1) / chunk;
+        std::vector<std::array<double,3>> sums(chunks, {0,0,0});
+        parallel_for(chunks, [&](int c)
+        {
+            for(int i = c * chunk; i < std::min(N, (c+1) * chunk); ++i)
+                for(int d = 0; d < 3; ++d)
+                    sums[c][d] += points_ptr[3*i+d];
+        });
+        double center[3] = {0, 0, 0};
+        for(int c = 0; c < chunks; ++c)
+            for(int d = 0; d < 3; ++d)
+                center[d] += sums[c][d];
+        for(int d = 0; d < 3; ++d)
+            center[d] = 0 < N ? center[d] / N : 0;
+
+        float s = 1;
+        if(scale)
+        {
+            std::vector<float> radii(std::max(chunks, 1), 0.f);
+            parallel_for(chunks, [&](int c)
+            {
+                for(int i = c * chunk; i < std::min(N, (c+1) * chunk); ++i) {
+                    const float dx = points_ptr[3*i+0] - center[0];
+                    const float dy = points_ptr[3*i+1] - center[1];
+                    const float dz = points_ptr[3*i+2] - center[2];
+                    radii[c] = std::max(radii[c], dx*dx + dy*dy + dz*dz);
+                }
+            });
+            const float r = std::sqrt(*std::max_element(radii.begin(), radii.end()));
+            s = 0 < r ? 1 / r : 1;
+        }
+        // p <- s (p - c)
+        *m = {
+            s, 0, 0, float(-s * center[0]),
+            0, s, 0, float(-s * center[1]),
+            0, 0, s, float(-s * center[2])};
+        return points;
+    }, [m](float* xyz, int n) {
+        return affine(xyz, n, m->data());
+    }});
+}
+
+void Pipeline::grid2d(float cell_size, float points_per_cell, bool sort_z)
+{
+    TORCH_CHECK(not m_grid, "grid2d must be the last stage");
+    TORCH_CHECK((0 < cell_size) != (0 < points_per_cell),
+        "exactly one of cell_size and points_per_cell must be positive");
+    m_grid = true;
+    m_cell_size = cell_size;
+    m_points_per_cell = points_per_cell;
+    m_sort_z = sort_z;
+    m_times.clear();
+}
+
+// Execution -------------------------------------------------------------------
+
+int Pipeline::process(float* xyz, int n, const std::vector<int>& stages, double* times) const
+{
+    for(int s : stages)
+    {
+        if(n == 0)
+            break;
+        const auto start = Clock::now();
+        n = m_stages[s].chunk(xyz, n);
+        times[s] += seconds_since(start);
+    }
+    return n;
+}
+
+torch::Tensor Pipeline::stream(torch::Tensor points, const std::vector<int>& stages)
+{
+    if(stages.empty())
+        return points;
+
+    // each chunk is copied at its place in the output and processed in place,
+    // its points are then moved down behind the points kept by the previous
+    // chunks, so the pass holds a single buffer of the size of the cloud
+    const int N = points.size(0);
+    const int S = m_stages.size();
+    const int C = m_chunk_size;
+    const int chunks = (N + C - 1) / C;
+    const float* points_ptr = points.data_ptr<float>();
+    auto output = torch::empty({N,3}, torch::kFloat32);
+    float* output_ptr = output.data_ptr<float>();
+    std::vector<int> kept(chunks);
+    std::vector<double> times(int64_t(chunks) * S, 0.0);
+    parallel_for(chunks, [&](int c)
+    {
+        const int64_t begin = int64_t(c) * C;
+        const int n = std::min<int64_t>(N, begin + C) - begin;
+        float* xyz = output_ptr + 3 * begin;
+        std::copy(points_ptr + 3 * begin, points_ptr + 3 * (begin + n), xyz);
+        kept[c] = process(xyz, n, stages, times.data() + int64_t(c) * S);
+    });
+
+    int64_t M = 0;
+    for(int c = 0; c < chunks; ++c) {
+        const int64_t begin = int64_t(c) * C;
+        if(M < begin)
+            std::memmove(output_ptr + 3 * M, output_ptr + 3 * begin, 3 * sizeof(float) * kept[c]);
+        M += kept[c];
+        for(int s : stages)
+            m_times[s] += times[int64_t(c) * S + s];
+    }
+    return output.narrow(0, 0, M);
+}
+
+Pipeline::Result Pipeline::execute(torch::Tensor points, int first)
+{
+    const int S = m_stages.size();
+    std::vector<int> pending;
+    for(int s = first; s < S; ++s)
+    {
+        const Stage& stage = m_stages[s];
+        if(stage.cloud) {
+            points = stream(points, pending);
+            pending.clear();
+            const auto start = Clock::now();
+            points = stage.cloud(points);
+            m_times[s] += seconds_since(start);
+        }
+        if(stage.chunk)
+            pending.push_back(s);
+    }
+    points = stream(points, pending);
+
+    if(not m_grid)
+        return std::make_tuple(points, torch::nullopt, torch::nullopt, torch::nullopt);
+    const auto start = Clock::now();
+    const auto [cells, indices, bounds] = build_grid2d_auto(points, m_cell_size, m_points_per_cell, m_sort_z);
+    m_times[S] += seconds_since(start);
+    return std::make_tuple(points, cells, indices, bounds);
+}
+
+Pipeline::Result Pipeline::run(torch::Tensor points)
+{
+    CHECK_CPU(points);
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(points.scalar_type() == torch::kFloat32, "points must be a float tensor");
+    m_times.assign(m_stages.size() + 1, 0.0);
+    m_read_time = -1;
+    return execute(points, 0);
+}
+
+torch::optional<Pipeline::Result> Pipeline::run_ply(const std::string& path)
+{
+    plyio::PLYReader reader;
+    std::ifstream fs;
+    const auto torch_dtype = internal::read_xyz_header(path, fs, reader);
+    if(not torch_dtype.has_value())
+        return {};
+    const auto ply_dtype = reader.property("vertex", "x").dtype();
+
+    // the first pass runs the streaming stages before the first whole cloud
+    // stage on the chunks of the decoder
+    int first = 0;
+    while(first < int(m_stages.size()) and not m_stages[first].cloud)
+        ++first;
+    std::vector<int> fused(first);
+    std::iota(fused.begin(), fused.end(), 0);
+
+    m_times.assign(m_stages.size() + 1, 0.0);
+    const int C = m_chunk_size;
+    const int size = plyio::internal::size_of(ply_dtype);
+    auto chunk = torch::empty({C,3}, torch::TensorOptions().dtype(torch_dtype.value()));
+    void* chunk_ptr = chunk.data_ptr();
+    reader.property("vertex", "x").read(chunk_ptr, 0 * size, 3 * size);
+    reader.property("vertex", "y").read(chunk_ptr, 1 * size, 3 * size);
+    reader.property("vertex", "z").read(chunk_ptr, 2 * size, 3 * size);
+    // the decoded chunks are converted behind the points already kept and
+    // processed in place there
+    auto points = torch::empty({reader.element_count("vertex"), 3}, torch::kFloat32);
+    int64_t kept = 0;
+    reader.read_chunks("vertex", C, [&](int begin, int end)
+    {
+        const int n = end - begin;
+        auto xyz = points.narrow(0, kept, n);
+        xyz.copy_(chunk.narrow(0, 0, n));
+        kept += process(xyz.data_ptr<float>(), n, fused, m_times.data());
+    });
+    const auto start = Clock::now();
+    reader.read_body(fs);
+    m_read_time = seconds_since(start);
+    for(int s : fused)
+        m_read_time -= m_times[s];
+    if(reader.has_error()) {
+        for(const std::string& err : reader.errors())
+            TORCH_WARN(err);
+        return {};
+    }
+
+    return execute(points.narrow(0, 0, kept), first);
+}
+
+std::vector<std::pair<std::string,double>> Pipeline::timings() const
+{
+    std::vector<std::pair<std::string,double>> timings;
+    if(m_times.empty())
+        return timings;
+    if(0 <= m_read_time)
+        timings.emplace_back("read_ply", m_read_time);
+    for(size_t s = 0; s < m_stages.size(); ++s)
+        timings.emplace_back(m_stages[s].name, m_times[s]);
+    if(m_grid)
+        timings.emplace_back("grid2d", m_times.back());
+    return timings;
+}
+
+} // namespace torch_points
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// lazy preprocessing pipeline of 3D points
+//
+// the stages are recorded by the builder methods and executed by run() or
+// run_ply(), they have the semantics of the functions of the same name
+//
+// consecutive streaming stages (crops and affine transforms) are fused: the
+// points go through them chunk by chunk, each chunk being transformed and
+// compacted in place in the output buffer of the pass while it is in cache,
+// so no intermediate (N,3) tensor is allocated between them; with run_ply()
+// the chunks of the first pass are filled directly by the PLY body decoder,
+// so the file is only decoded into the buffer of the first pass
+//
+// the other stages need the whole cloud and run the existing kernels between
+// the fused passes, normalize() computes its centroid and scale on the whole
+// cloud and is then fused as an affine transform with the next streaming
+// stages; grid2d() must be the last stage
+//
+// run(points)
+//      points: float (N,3)
+// run_ply(path)
+//      points are the x/y/z vertex properties, None if the file can not be read
+//
+//      points:  float (M,3):             points at the end of the pipeline
+//      cells:   optional int (Nx,Ny,2):  grid2d() cells
+//      indices: optional int (M):        grid2d() indices in points
+//      bounds:  optional float (4):      grid2d() xmin/xmax/ymin/ymax
+//
+// timings() returns the seconds spent in each stage during the last run, in
+// the order of the stages after a "read_ply" entry for the PLY decoding
+// the times of fused stages are summed over the chunks, and so over the
+// threads when the chunks are processed in parallel
+//
+class Pipeline
+{
+public:
+    using Result = std::tuple<
+        torch::Tensor,                  // points
+        torch::optional<torch::Tensor>, // cells
+        torch::optional<torch::Tensor>, // indices
+        torch::optional<torch::Tensor>>;// bounds
+
+    Pipeline(int chunk_size = 16384);
+
+    // streaming stages
+    void crop_box(torch::Tensor bounds);
+    void crop_obb(torch::Tensor center, torch::Tensor rotation, torch::Tensor extent);
+    void crop_polygon(torch::Tensor polygon, torch::optional<torch::Tensor> rings);
+    void transform(torch::Tensor matrix);
+
+    // whole cloud stages
+    void voxel_downsample(float voxel_size, const std::string& mode);
+    void remove_statistical_outliers(int k, float std_ratio);
+    void remove_radius_outliers(float r, int min_neighbors);
+    void normalize(bool scale);
+    void grid2d(float cell_size, float points_per_cell, bool sort_z);
+
+    Result run(torch::Tensor points);
+    torch::optional<Result> run_ply(const std::string& path);
+
+    std::vector<std::pair<std::string,double>> timings() const;
+
+protected:
+    // transforms and compacts n points in place, returns the number of points kept
+    using ChunkOp = std::function<int(float*,int)>;
+
+    // returns the points at the end of the stage
+    using CloudOp = std::function<torch::Tensor(torch::Tensor)>;
+
+    // a stage has a chunk operation, a cloud operation, or both (normalize),
+    // in which case the cloud operation runs first
+    struct Stage
+    {
+        std::string name;
+        CloudOp cloud;
+        ChunkOp chunk;
+    };
+
+    void add(Stage stage);
+
+    // runs the stages from first on points
+    Result execute(torch::Tensor points, int first);
+
+    // one pass of the chunk operations of the given stages over points
+    torch::Tensor stream(torch::Tensor points, const std::vector<int>& stages);
+
+    // chunk operations of the given stages on one chunk, their times are added to times
+    int process(float* xyz, int n, const std::vector<int>& stages, double* times) const;
+
+protected:
+    int m_chunk_size;
+    std::vector<Stage> m_stages;
+
+    // grid2d() parameters
+    bool m_grid;
+    float m_cell_size;
+    float m_points_per_cell;
+    bool m_sort_z;
+
+    // set by the last run
+    std::vector<double> m_times;    // seconds of each stage, then of grid2d()
+    double m_read_time;             // seconds of the PLY decoding, -1 for run()
+};
+
+} // namespace torch_points
@@ -0,0 +1,272 @@
+#include <torch_points/registration/icp.h>
+#include <torch_points/features/normals.h>
+#include <torch_points/common/check.h>
+
+namespace torch_points {
+
+namespace {
+
+//
+// normal equations A x = -b of the residuals e + J x, x = (rotation vector, translation)
+// only the upper triangle of A is accumulated
+//
+struct NormalEquations
+{
+    double A[6][6];
+    double b[6];
+    double sse;
+    int64_t count;
+
+    void zero()
+    {
+        std::fill(&A[0][0], &A[0][0] + 36, 0.);
+        std::fill(b, b + 6, 0.);
+        sse = 0;
+        count = 0;
+    }
+
+    void add(const double J[6], double e)
+    {
+        for(int r = 0; r < 6; ++r) {
+            for(int c = r; c < 6; ++c)
+                A[r][c] += J[r] * J[c];
+            b[r] += J[r] * e;
+        }
+        sse += e * e;
+    }
+
+    void merge(const NormalEquations& other)
+    {
+        for(int r = 0; r < 6; ++r) {
+            for(int c = r; c < 6; ++c)
+                A[r][c] += other.A[r][c];
+            b[r] += other.b[r];
+        }
+        sse += other.sse;
+        count += other.count;
+    }
+
+    // Cholesky solve, false if A is not positive definite
+    bool solve(double x[6]) const
+    {
+        double L[6][6] = {};
+        for(int r = 0; r < 6; ++r)
+        {
+            for(int c = 0; c <= r; ++c)
+            {
+                double s = A[c][r];
+                for(int k = 0; k < c; ++k)
+                    s -= L[r][k] * L[c][k];
+                if(r == c) {
+                    if(not (s > 1e-12 * (A[0][0] + A[3][3])))
+                        return false;
+                    L[r][r] = std::sqrt(s);
+                } else {
+                    L[r][c] = s / L[c][c];
+                }
+            }
+        }
+        double y[6];
+        for(int r = 0; r < 6; ++r) {
+            y[r] = -b[r];
+            for(int k = 0; k < r; ++k)
+                y[r] -= L[r][k] * y[k];
+            y[r] /= L[r][r];
+        }
+        for(int r = 5; 0 <= r; --r) {
+            x[r] = y[r];
+            for(int k = r + 1; k < 6; ++k)
+                x[r] -= L[k][r] * x[k];
+            x[r] /= L[r][r];
+        }
+        return true;
+    }
+};
+
+// rotation matrix of the rotation vector w (Rodrigues formula)
+void rotation(const double w[3], double R[3][3])
+{
+    const double theta = std::sqrt(w[0]*w[0] + w[1]*w[1] + w[2]*w[2]);
+    const double s = theta < 1e-12 ? 1 : std::sin(theta) / theta;
+    const double c = theta < 1e-12 ? 0.5 : (1 - std::cos(theta)) / (theta * theta);
+    const double K[3][3] = {{0, -w[2], w[1]}, {w[2], 0, -w[0]}, {-w[1], w[0], 0}};
+    for(int i = 0; i < 3; ++i)
+    for(int j = 0; j < 3; ++j)
+    {
+        double K2 = 0;
+        for(int k = 0; k < 3; ++k)
+            K2 += K[i][k] * K[k][j];
+        R[i][j] = (i == j) + s * K[i][j] + c * K2;
+    }
+}
+
+} // anonymous namespace
+
+ICP::ICP(torch::Tensor target, torch::optional<torch::Tensor> target_normals) :
+    m_target(target),
+    m_normals(),
+    m_grid()
+{
+    CHECK_CPU(target);
+    CHECK_POINTS(target);
+    CHECK_CONTIGUOUS(target);
+    if(target_normals.has_value())
+    {
+        CHECK_CPU(target_normals.value());
+        CHECK_POINTS(target_normals.value());
+        CHECK_CONTIGUOUS(target_normals.value());
+        TORCH_CHECK(target_normals.value().size(0) == target.size(0), 
+            "target_normals must have the size of target");
+        m_normals = target_normals.value();
+    }
+    m_grid.build(target.data_ptr<float>(), 0, target.size(0), 0);
+}
+
+std::pair<torch::Tensor,torch::Tensor> ICP::align(
+    torch::Tensor source,
+    int max_iters,
+    float max_dist,
+    const std::string& mode,
+    torch::optional<torch::Tensor> init,
+    float tolerance)
+{
+    CHECK_CPU(source);
+    CHECK_POINTS(source);
+    CHECK_CONTIGUOUS(source);
+    TORCH_CHECK(0 <= max_iters, "max_iters must be non-negative");
+    TORCH_CHECK(0 < max_dist, "max_dist must be positive");
+    TORCH_CHECK(mode == "point_to_point" or mode == "point_to_plane", 
+        "mode must be point_to_point or point_to_plane");
+    const bool plane = mode == "point_to_plane";
+    if(plane and not m_normals.defined())
+        m_normals = estimate_normals(m_target, 16, 0, torch::nullopt);
+
+    // current transform p -> R p + t
+    double R[3][3] = {{1,0,0}, {0,1,0}, {0,0,1}};
+    double t[3] = {0,0,0};
+    if(init.has_value())
+    {
+        const auto& T = init.value();
+        CHECK_CPU(T);
+        TORCH_CHECK(T.dim() == 2 and T.size(0) == 4 and T.size(1) == 4, "init must have size [4,4]");
+        const auto T_float = T.to(torch::kFloat32).contiguous();
+        const float* T_ptr = T_float.data_ptr<float>();
+        for(int i = 0; i < 3; ++i) {
+            for(int j = 0; j < 3; ++j)
+                R[i][j] = T_ptr[4*i+j];
+            t[i] = T_ptr[4*i+3];
+        }
+    }
+
+    const int N = source.size(0);
+    const float* source_ptr = source.data_ptr<float>();
+    const float* target_ptr = m_target.data_ptr<float>();
+    const float* normals_ptr = plane ? m_normals.data_ptr<float>() : nullptr;
+    const float max_d2 = std::isinf(max_dist) ? INFINITY : max_dist * max_dist;
+
+    // fixed chunks, merged in order
+    const int64_t chunk = 2048;
+    const int64_t chunks = (N + chunk - 1) / chunk;
+    std::vector<NormalEquations> partial(chunks);
+    std::vector<float> residuals;
+    for(int iter = 0; iter < max_iters; ++iter)
+    {
+        at::parallel_for(0, chunks, 1, [&](int64_t c_begin, int64_t c_end)
+        {
+            for(int64_t c = c_begin; c < c_end; ++c)
+            {
+                NormalEquations& eq = partial[c];
+                eq.zero();
+                for(int64_t i = c * chunk; i < std::min<int64_t>(N, (c+1) * chunk); ++i)
+                {
+                    const float* s = source_ptr + 3 * i;
+                    float p[3];
+                    for(int d = 0; d < 3; ++d)
+                        p[d] = R[d][0] * s[0] + R[d][1] * s[1] + R[d][2] * s[2] + t[d];
+                    int j;
+                    float d2;
+                    internal::KnnHeap heap(&j, &d2, 1, max_d2);
+                    m_grid.search(p, heap);
+                    if(heap.count == 0)
+                        continue;
+                    const float* q = target_ptr + 3 * int64_t(j);
+                    ++eq.count;
+                    if(plane)
+                    {
+                        // e = n.(p - q), de/dw = p x n, de/dt = n
+                        const float* n = normals_ptr + 3 * int64_t(j);
+                        const double J[6] = {
+                            p[1]*n[2] - p[2]*n[1], p[2]*n[0] - p[0]*n[2], p[0]*n[1] - p[1]*n[0],
+                            n[0], n[1], n[2]};
+                        eq.add(J, n[0]*(p[0]-q[0]) + n[1]*(p[1]-q[1]) + n[2]*(p[2]-q[2]));
+                    }
+                    else
+                    {
+                        // e = p - q, de/dw = -[p]x, de/dt = I
+                        const double J[3][6] = {
+                            {0, p[2], -p[1], 1, 0, 0},
+                            {-p[2], 0, p[0], 0, 1, 0},
+                            {p[1], -p[0], 0, 0, 0, 1}};
+                        for(int d = 0; d < 3; ++d)
+                            eq.add(J[d], p[d] - q[d]);
+                    }
+                }
+            }
+        });
+        NormalEquations eq;
+        eq.zero();
+        for(const auto& other : partial)
+            eq.merge(other);
+        if(eq.count == 0)
+            break;
+        residuals.push_back(std::sqrt(eq.sse / eq.count));
+
+        double x[6];
+        if(not eq.solve(x))
+            break;
+        double dR[3][3];
+        rotation(x, dR);
+        double R_new[3][3], t_new[3];
+        for(int i = 0; i < 3; ++i) {
+            for(int j = 0; j < 3; ++j)
+                R_new[i][j] = dR[i][0] * R[0][j] + dR[i][1] * R[1][j] + dR[i][2] * R[2][j];
+            t_new[i] = dR[i][0] * t[0] + dR[i][1] * t[1] + dR[i][2] * t[2] + x[3+i];
+        }
+        std::copy(&R_new[0][0], &R_new[0][0] + 9, &R[0][0]);
+        std::copy(t_new, t_new + 3, t);
+
+        double norm = 0;
+        for(int k = 0; k < 6; ++k)
+            norm += x[k] * x[k];
+        if(std::sqrt(norm) < tolerance)
+            break;
+    }
+
+    auto transform = torch::zeros({4,4}, torch::kFloat32);
+    float* transform_ptr = transform.data_ptr<float>();
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 3; ++j)
+            transform_ptr[4*i+j] = R[i][j];
+        transform_ptr[4*i+3] = t[i];
+    }
+    transform_ptr[15] = 1;
+    auto residuals_tensor = torch::empty({int64_t(residuals.size())}, torch::kFloat32);
+    std::copy(residuals.begin(), residuals.end(), residuals_tensor.data_ptr<float>());
+    return std::make_pair(transform, residuals_tensor);
+}
+
+std::pair<torch::Tensor,torch::Tensor> icp(
+    torch::Tensor source,
+    torch::Tensor target,
+    int max_iters,
+    float max_dist,
+    const std::string& mode,
+    torch::optional<torch::Tensor> target_normals,
+    torch::optional<torch::Tensor> init,
+    float tolerance)
+{
+    ICP registration(target, target_normals);
+    return registration.align(source, max_iters, max_dist, mode, init, tolerance);
+}
+
+} // namespace torch_points
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <torch/extension.h>
+#include <torch_points/spatial/internal/grid3D.h>
+
+namespace torch_points {
+
+//
+// iterative closest point registration of source points onto a target
+//
+// the target is indexed once in a uniform 3D grid, so an ICP object can align
+// several sources; at each iteration the nearest target point of each
+// transformed source point is searched in parallel, the correspondences farther
+// than max_dist are rejected and the 6x6 normal equations of the linearized
+// residuals are accumulated in fixed chunks (the result does not depend on the
+// number of threads), then the rotation/translation update is solved by Cholesky
+//
+// mode
+//      "point_to_point": residuals are the vectors p - q
+//      "point_to_plane": residuals are the distances n.(p - q), n being the target
+//                        normals, estimated from 16 neighbors if not given
+//
+// align(source, max_iters, max_dist, mode, init, tolerance)
+//      source: float (N,3)
+//      init:   optional float (4,4) initial transform, identity by default
+//      iterations stop when the norm of the update is less than tolerance
+//
+//      transform: float (4,4): transform of the source onto the target
+//      residuals: float (I):   RMS residual of the correspondences of each iteration
+//
+class ICP
+{
+public:
+    ICP(torch::Tensor target, torch::optional<torch::Tensor> target_normals = torch::nullopt);
+
+    std::pair<torch::Tensor,torch::Tensor> align(
+        torch::Tensor source,
+        int max_iters,
+        float max_dist,
+        const std::string& mode,
+        torch::optional<torch::Tensor> init,
+        float tolerance);
+
+protected:
+    torch::Tensor m_target;
+    torch::Tensor m_normals;    // undefined until needed
+    internal::Grid3D m_grid;
+};
+
+std::pair<torch::Tensor,torch::Tensor> icp(
+    torch::Tensor source,
+    torch::Tensor target,
+    int max_iters,
+    float max_dist,
+    const std::string& mode,
+    torch::optional<torch::Tensor> target_normals,
+    torch::optional<torch::Tensor> init,
+    float tolerance);
+
+} // namespace torch_points
@@ -0,0 +1,195 @@
+#include <torch_points/sampling/fps.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+
+namespace torch_points {
+
+namespace {
+
+struct Farthest
+{
+    float d2;
+    int index;
+};
+
+// the first index wins ties, so the result does not depend on the chunks
+Farthest farthest(const Farthest& a, const Farthest& b)
+{
+    return b.d2 > a.d2 or (b.d2 == a.d2 and b.index < a.index and 0 <= b.index) ? b : a;
+}
+
+//
+// min-distance update of the points begin:end with the point q
+// blocks are updated by a vectorized loop that also computes their maximum,
+// the index of the maximum is only searched in the blocks that improve it
+//
+Farthest update_distances(
+    const float* x,
+    const float* y,
+    const float* z,
+    float* dist,
+    int64_t begin,
+    int64_t end,
+    const float* q)
+{
+    constexpr int block = 256;
+    Farthest result = {-1, -1};
+    for(int64_t b = begin; b < end; b += block)
+    {
+        const int64_t e = std::min(end, b + block);
+        float max_d2 = -1;
+        for(int64_t i = b; i < e; ++i) {
+            const float dx = x[i] - q[0];
+            const float dy = y[i] - q[1];
+            const float dz = z[i] - q[2];
+            dist[i] = std::min(dist[i], dx*dx + dy*dy + dz*dz);
+            max_d2 = std::max(max_d2, dist[i]);
+        }
+        if(result.d2 < max_d2)
+            result = {max_d2, static_cast<int>(std::find(dist + b, dist + e, max_d2) - dist)};
+    }
+    return result;
+}
+
+//
+// M farthest points among the n points x/y/z starting with start,
+// selected points get a negative distance so they are never selected twice
+//
+void fps(
+    const float* x,
+    const float* y,
+    const float* z,
+    int n,
+    int M,
+    int start,
+    int* out,
+    bool parallel)
+{
+    std::vector<float> dist(n, INFINITY);
+    int last = start;
+    for(int m = 0; m < M; ++m)
+    {
+        out[m] = last;
+        dist[last] = -1;
+        if(m + 1 == M)
+            break;
+        const float q[3] = {x[last], y[last], z[last]};
+        const auto update = [&](int64_t begin, int64_t end, const Farthest&) {
+            return update_distances(x, y, z, dist.data(), begin, end, q);
+        };
+        last = parallel ?
+            at::parallel_reduce(0, n, 8192, Farthest{-1, -1}, update, farthest).index :
+            update(0, n, {}).index;
+    }
+}
+
+//
+// one point per non-empty cell of a grid over points begin:end with at least
+// 4*M non-empty cells, the cell of start is represented by start
+// empty if the grid would have about as many cells as points
+//
+std::vector<int> cell_representatives(const float* points, int begin, int end, int M, int start)
+{
+    const int n = end - begin;
+    internal::Grid3D grid;
+    for(float ppc = float(n) / (4.f * M); 1 < ppc; ppc /= 4)
+    {
+        grid.build(points, begin, end, 0, ppc);
+        const int C = grid.m_offsets.size() - 1;
+        const int start_cell = grid.cell_index(points + 3 * int64_t(start));
+        std::vector<int> representatives;
+        for(int c = 0; c < C; ++c) {
+            if(grid.m_offsets[c] == grid.m_offsets[c+1])
+                continue;
+            representatives.push_back(c == start_cell ? start : grid.m_indices[grid.m_offsets[c]]);
+        }
+        if(4 * M <= int(representatives.size()))
+            return representatives;
+    }
+    return {};
+}
+
+// M samples of points begin:end written in out
+void sample(const float* points, int begin, int end, int M, int start_idx, bool approximate, int* out, bool parallel)
+{
+    std::vector<int> candidates;
+    if(approximate)
+        candidates = cell_representatives(points, begin, end, M, begin + start_idx);
+    if(candidates.empty()) {
+        candidates.resize(end - begin);
+        std::iota(candidates.begin(), candidates.end(), begin);
+    }
+    const int n = candidates.size();
+    const int start = std::find(candidates.begin(), candidates.end(), begin + start_idx) - candidates.begin();
+
+    std::vector<float> x(n), y(n), z(n);
+    for(int i = 0; i < n; ++i) {
+        const float* p = points + 3 * int64_t(candidates[i]);
+        x[i] = p[0];
+        y[i] = p[1];
+        z[i] = p[2];
+    }
+    fps(x.data(), y.data(), z.data(), n, M, start, out, parallel);
+    for(int m = 0; m < M; ++m)
+        out[m] = candidates[out[m]];
+}
+
+} // anonymous namespace
+
+torch::Tensor sample_points_fps(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    int M,
+    int start_idx,
+    bool approximate)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < M, "M must be positive");
+    TORCH_CHECK(0 <= start_idx, "start_idx must be non-negative");
+    DISPATCH(points.device(), sample_points_fps, 
+        points, offsets, M, start_idx, approximate);
+}
+
+torch::Tensor sample_points_fps_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    int M,
+    int start_idx,
+    bool approximate)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const std::vector<int> sample_offsets = check_offsets(offsets, N);
+    const int B = sample_offsets.size() - 1;
+    for(int b = 0; b < B; ++b)
+    {
+        const int n = sample_offsets[b+1] - sample_offsets[b];
+        TORCH_CHECK(M <= n, "sample ", b, " has less than M points");
+        TORCH_CHECK(start_idx < n, "start_idx is out of sample ", b);
+    }
+
+    auto indices = torch::empty({int64_t(B) * M}, torch::kInt32);
+    int* indices_ptr = indices.data_ptr<int>();
+    const auto run = [&](int64_t b, bool parallel) {
+        sample(points_ptr, sample_offsets[b], sample_offsets[b+1], M, start_idx, 
+            approximate, indices_ptr + b * M, parallel);
+    };
+    // samples are processed in parallel when there are enough of them,
+    // otherwise one after the other with parallel distance updates
+    if(at::get_num_threads() <= B) {
+        at::parallel_for(0, B, 1, [&](int64_t b_begin, int64_t b_end) {
+            for(int64_t b = b_begin; b < b_end; ++b)
+                run(b, false);
+        });
+    } else {
+        for(int b = 0; b < B; ++b)
+            run(b, true);
+    }
+    return indices;
+}
+
+} // namespace torch_points
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// farthest point sampling
+//
+// points:    float (N,3)
+// offsets:   optional int (B+1): points offsets[b]:offsets[b+1] are the sample b,
+//            M points are selected in each sample
+// start_idx: index of the first selected point in each sample
+//
+// returns
+//      indices: int (B*M): indices in points, the M first ones are in the
+//               sample 0, the next M ones in the sample 1, etc
+//
+// the distances to the selected points are updated in parallel over the points,
+// or over the samples when there are enough of them
+//
+// approximate: if true, the sampling is done among one representative point
+//              per cell of a uniform grid with about 4*M non-empty cells,
+//              which is much faster when N is large compared to M
+//
+torch::Tensor sample_points_fps(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    int M,
+    int start_idx = 0,
+    bool approximate = false);
+
+torch::Tensor sample_points_fps_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    int M,
+    int start_idx = 0,
+    bool approximate = false);
+
+} // namespace torch_points
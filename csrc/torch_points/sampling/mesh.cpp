@@ -0,0 +1,164 @@
+#include <torch_points/sampling/mesh.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/hash.h>
+
+#include <atomic>
+
+namespace torch_points {
+
+namespace {
+
+// inclusive prefix sum in place, each chunk is summed then offset by the previous ones
+void inclusive_scan(std::vector<double>& values)
+{
+    const int64_t N = values.size();
+    const int64_t T = std::max<int64_t>(1, std::min<int64_t>(at::get_num_threads(), N / 16384));
+    const int64_t chunk = (N + T - 1) / T;
+    std::vector<double> sums(T + 1, 0.);
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+        {
+            double sum = 0;
+            for(int64_t i = t * chunk; i < std::min(N, (t+1) * chunk); ++i) {
+                sum += values[i];
+                values[i] = sum;
+            }
+            sums[t+1] = sum;
+        }
+    });
+    for(int64_t t = 0; t < T; ++t)
+        sums[t+1] += sums[t];
+    at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+    {
+        for(int64_t t = t_begin; t < t_end; ++t)
+            for(int64_t i = t * chunk; i < std::min(N, (t+1) * chunk); ++i)
+                values[i] += sums[t];
+    });
+}
+
+template<typename IndexT>
+void sample_surface(
+    const float* vertices,
+    int64_t V,
+    const IndexT* faces,
+    int64_t F,
+    int64_t M,
+    uint64_t seed,
+    float* points,
+    float* normals,
+    int64_t* sampled_faces)
+{
+    // 1. cumulative areas (twice the areas, the scale does not matter)
+    std::vector<double> cdf(F);
+    std::atomic<bool> valid(true);
+    at::parallel_for(0, F, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t f = begin; f < end; ++f)
+        {
+            const IndexT* face = faces + 3 * f;
+            if(not (0 <= face[0] and face[0] < V and 0 <= face[1] and face[1] < V 
+                and 0 <= face[2] and face[2] < V)) {
+                valid = false;
+                cdf[f] = 0;
+                continue;
+            }
+            const float* a = vertices + 3 * int64_t(face[0]);
+            const float* b = vertices + 3 * int64_t(face[1]);
+            const float* c = vertices + 3 * int64_t(face[2]);
+            const double u[3] = {double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+            const double v[3] = {double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+            const double n[3] = {u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0]};
+            cdf[f] = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+        }
+    });
+    TORCH_CHECK(valid, "faces must be in [0,V)");
+    inclusive_scan(cdf);
+    const double total = F == 0 ? 0 : cdf[F-1];
+    TORCH_CHECK(M == 0 or 0 < total, "the mesh must have a positive area");
+
+    // 2. samples, from 2 hashes each: 53 bits for the face, 2x24 bits for the barycentric coordinates
+    at::parallel_for(0, M, 1024, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t m = begin; m < end; ++m)
+        {
+            const uint64_t h0 = hash64(seed, 2 * uint64_t(m));
+            const uint64_t h1 = hash64(seed, 2 * uint64_t(m) + 1);
+            const double target = (h0 >> 11) * (1. / 9007199254740992.) * total;
+            const int64_t f = std::min<int64_t>(
+                std::upper_bound(cdf.begin(), cdf.end(), target) - cdf.begin(), F - 1);
+            sampled_faces[m] = f;
+
+            // uniform in the triangle: s = sqrt(r1), (1-s, s(1-r2), s r2)
+            const float s = std::sqrt(hash_uniform(h1));
+            const float r2 = hash_uniform(h1 << 24);
+            const float w[3] = {1 - s, s * (1 - r2), s * r2};
+            const IndexT* face = faces + 3 * f;
+            const float* a = vertices + 3 * int64_t(face[0]);
+            const float* b = vertices + 3 * int64_t(face[1]);
+            const float* c = vertices + 3 * int64_t(face[2]);
+            float* p = points + 3 * m;
+            for(int d = 0; d < 3; ++d)
+                p[d] = w[0] * a[d] + w[1] * b[d] + w[2] * c[d];
+            if(normals == nullptr)
+                continue;
+
+            const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            float* n = normals + 3 * m;
+            n[0] = u[1]*v[2] - u[2]*v[1];
+            n[1] = u[2]*v[0] - u[0]*v[2];
+            n[2] = u[0]*v[1] - u[1]*v[0];
+            const float norm = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+            const float scale = 0 < norm ? 1 / norm : 0;
+            for(int d = 0; d < 3; ++d)
+                n[d] *= scale;
+        }
+    });
+}
+
+} // anonymous namespace
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> sample_mesh_surface(
+    torch::Tensor vertices,
+    torch::Tensor faces,
+    int64_t M,
+    bool with_normals,
+    int64_t seed)
+{
+    CHECK_POINTS(vertices);
+    CHECK_CONTIGUOUS(vertices);
+    CHECK_CONTIGUOUS(faces);
+    TORCH_CHECK(faces.dim() == 2 and faces.size(1) == 3, "faces must have size [F,3]");
+    TORCH_CHECK(faces.scalar_type() == torch::kInt32 or faces.scalar_type() == torch::kInt64, 
+        "faces must be int or long");
+    TORCH_CHECK(0 <= M, "M must be non-negative");
+    DISPATCH(vertices.device(), sample_mesh_surface, vertices, faces, M, with_normals, seed);
+}
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> sample_mesh_surface_cpu(
+    torch::Tensor vertices,
+    torch::Tensor faces,
+    int64_t M,
+    bool with_normals,
+    int64_t seed)
+{
+    CHECK_CPU(vertices);
+    CHECK_CPU(faces);
+    auto points = torch::empty({M,3}, torch::kFloat32);
+    auto sampled_faces = torch::empty({M}, torch::kInt64);
+    torch::optional<torch::Tensor> normals;
+    if(with_normals)
+        normals = torch::empty({M,3}, torch::kFloat32);
+    float* normals_ptr = with_normals ? normals->data_ptr<float>() : nullptr;
+    if(faces.scalar_type() == torch::kInt64)
+        sample_surface(vertices.data_ptr<float>(), vertices.size(0), faces.data_ptr<int64_t>(), faces.size(0), 
+            M, seed, points.data_ptr<float>(), normals_ptr, sampled_faces.data_ptr<int64_t>());
+    else
+        sample_surface(vertices.data_ptr<float>(), vertices.size(0), faces.data_ptr<int>(), faces.size(0), 
+            M, seed, points.data_ptr<float>(), normals_ptr, sampled_faces.data_ptr<int64_t>());
+    return std::make_tuple(points, normals, sampled_faces);
+}
+
+} // namespace torch_points
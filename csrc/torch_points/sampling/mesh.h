@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// uniform random sampling of the surface of a triangle mesh
+//
+// vertices:     float (V,3)
+// faces:        int or long (F,3): vertex indices of each triangle
+// M:            number of points
+// with_normals: the normals of the sampled faces are returned
+// seed:         the sample m only depends on the seed and m, not on the number of threads
+//
+// returns
+//      points:  float (M,3)
+//      normals: float (M,3): unit normal of the face of each point, oriented by
+//               the order of its vertices (zero for degenerate faces)
+//      faces:   long (M):    face of each point
+//
+// faces are drawn with probability proportional to their area by a binary search
+// in the cumulative areas (computed by a parallel prefix sum in double precision),
+// points are placed in their face by uniform barycentric coordinates
+//
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> sample_mesh_surface(
+    torch::Tensor vertices,
+    torch::Tensor faces,
+    int64_t M,
+    bool with_normals,
+    int64_t seed);
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> sample_mesh_surface_cpu(
+    torch::Tensor vertices,
+    torch::Tensor faces,
+    int64_t M,
+    bool with_normals,
+    int64_t seed);
+
+} // namespace torch_points
@@ -0,0 +1,99 @@
+#include <torch_points/sampling/poisson.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/hash.h>
+
+namespace torch_points {
+
+torch::Tensor sample_points_poisson(
+    torch::Tensor points,
+    float r,
+    int64_t seed)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < r, "r must be positive");
+    DISPATCH(points.device(), sample_points_poisson, points, r, seed);
+}
+
+torch::Tensor sample_points_poisson_cpu(
+    torch::Tensor points,
+    float r,
+    int64_t seed)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const float r2 = r * r;
+
+    internal::Grid3D grid;
+    grid.build(points_ptr, 0, N, r);
+    const int* n = grid.m_n;
+
+    // selected[j] for the j-th point in cell order
+    std::vector<char> selected(N, 0);
+    for(int phase = 0; phase < 8; ++phase)
+    {
+        const int px = phase & 1;
+        const int py = (phase >> 1) & 1;
+        const int pz = (phase >> 2) & 1;
+        const int cx = (n[0] - px + 1) / 2;
+        const int cy = (n[1] - py + 1) / 2;
+        const int cz = (n[2] - pz + 1) / 2;
+        at::parallel_for(0, int64_t(cx) * cy * cz, 256, [&](int64_t begin, int64_t end)
+        {
+            std::vector<std::pair<uint64_t,int>> candidates;
+            for(int64_t k = begin; k < end; ++k)
+            {
+                const int ix = px + 2 * (k % cx);
+                const int iy = py + 2 * (k / cx % cy);
+                const int iz = pz + 2 * (k / cx / cy);
+                const int cell = (iz * n[1] + iy) * n[0] + ix;
+                const int cell_begin = grid.m_offsets[cell];
+                const int cell_end = grid.m_offsets[cell+1];
+                if(cell_begin == cell_end)
+                    continue;
+
+                candidates.clear();
+                for(int j = cell_begin; j < cell_end; ++j)
+                    candidates.emplace_back(hash64(seed, grid.m_indices[j]), j);
+                std::sort(candidates.begin(), candidates.end());
+
+                for(const auto& candidate : candidates)
+                {
+                    const int j = candidate.second;
+                    const float q[3] = {grid.m_x[j], grid.m_y[j], grid.m_z[j]};
+                    bool free = true;
+                    for(int z = std::max(iz-1, 0); free and z <= std::min(iz+1, n[2]-1); ++z)
+                    for(int y = std::max(iy-1, 0); free and y <= std::min(iy+1, n[1]-1); ++y)
+                    for(int x = std::max(ix-1, 0); free and x <= std::min(ix+1, n[0]-1); ++x)
+                    {
+                        const int neighbor = (z * n[1] + y) * n[0] + x;
+                        for(int i = grid.m_offsets[neighbor]; free and i < grid.m_offsets[neighbor+1]; ++i)
+                        {
+                            if(not selected[i])
+                                continue;
+                            const float dx = grid.m_x[i] - q[0];
+                            const float dy = grid.m_y[i] - q[1];
+                            const float dz = grid.m_z[i] - q[2];
+                            free = r2 <= dx*dx + dy*dy + dz*dz;
+                        }
+                    }
+                    selected[j] = free;
+                }
+            }
+        });
+    }
+
+    std::vector<int> indices;
+    for(int j = 0; j < N; ++j)
+        if(selected[j])
+            indices.push_back(grid.m_indices[j]);
+    std::sort(indices.begin(), indices.end());
+    auto result = torch::empty({int64_t(indices.size())}, torch::kInt32);
+    std::copy(indices.begin(), indices.end(), result.data_ptr<int>());
+    return result;
+}
+
+} // namespace torch_points
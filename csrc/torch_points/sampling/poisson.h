@@ -0,0 +1,32 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// Poisson-disk subsampling: maximal subset of points at least r apart
+//
+// points: float (N,3)
+// seed:   the result only depends on the seed and not on the number of threads
+//
+// returns
+//      indices: int (S): sorted indices in points of the selected points
+//
+// dart throwing in a uniform grid with cells of size at least r, so that a
+// candidate only checks the selected points in the 27 neighboring cells
+// cells are processed in 8 phases by parity of their coordinates (3D
+// checkerboard): two cells of the same phase are not neighbors, so they are
+// processed in parallel, the points of a cell are tried in a random order
+//
+torch::Tensor sample_points_poisson(
+    torch::Tensor points,
+    float r,
+    int64_t seed);
+
+torch::Tensor sample_points_poisson_cpu(
+    torch::Tensor points,
+    float r,
+    int64_t seed);
+
+} // namespace torch_points
@@ -0,0 +1,81 @@
+#include <torch_points/sampling/random.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+#include <torch_points/common/gather.h>
+#include <torch_points/common/random.h>
+
+namespace torch_points {
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> sample_points_random(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    torch::Tensor counts,
+    int64_t seed,
+    std::vector<torch::Tensor> attributes)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    for(const auto& attribute : attributes) {
+        CHECK_CONTIGUOUS(attribute);
+        TORCH_CHECK(1 <= attribute.dim() and attribute.size(0) == points.size(0), 
+            "attributes must have size [N,...]");
+    }
+    DISPATCH(points.device(), sample_points_random, 
+        points, offsets, counts, seed, attributes);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> sample_points_random_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    torch::Tensor counts,
+    int64_t seed,
+    std::vector<torch::Tensor> attributes)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(counts);
+    for(const auto& attribute : attributes)
+        CHECK_CPU(attribute);
+    const int N = points.size(0);
+    const std::vector<int> sample_offsets = check_offsets(offsets, N);
+    const int B = sample_offsets.size() - 1;
+    TORCH_CHECK(counts.dim() == 1 and (counts.size(0) == 1 or counts.size(0) == B), 
+        "counts must have size [1] or [B]");
+    const auto counts32 = counts.to(torch::kInt32).contiguous();
+    const int* counts_ptr = counts32.data_ptr<int>();
+
+    std::vector<int64_t> output_offsets(B + 1, 0);
+    for(int b = 0; b < B; ++b)
+    {
+        const int m = counts_ptr[counts.size(0) == 1 ? 0 : b];
+        TORCH_CHECK(0 <= m and m <= sample_offsets[b+1] - sample_offsets[b], 
+            "invalid number of points ", m, " in sample ", b);
+        output_offsets[b+1] = output_offsets[b] + m;
+    }
+    const int64_t M = output_offsets[B];
+
+    auto indices = torch::empty({M}, torch::kInt64);
+    int64_t* indices_ptr = indices.data_ptr<int64_t>();
+    at::parallel_for(0, B, 1, [&](int64_t b_begin, int64_t b_end)
+    {
+        for(int64_t b = b_begin; b < b_end; ++b)
+        {
+            // one generator per sample
+            std::mt19937_64 rng = make_generator(seed, b);
+            int64_t* out = indices_ptr + output_offsets[b];
+            const int m = output_offsets[b+1] - output_offsets[b];
+            sample_indices(sample_offsets[b+1] - sample_offsets[b], m, rng, out);
+            std::shuffle(out, out + m, rng);
+            for(int i = 0; i < m; ++i)
+                out[i] += sample_offsets[b];
+        }
+    });
+
+    std::vector<torch::Tensor> gathered;
+    gathered.reserve(attributes.size());
+    for(const auto& attribute : attributes)
+        gathered.push_back(gather_rows(attribute, indices_ptr, M));
+    return std::make_tuple(indices, gather_rows(points, indices_ptr, M), gathered);
+}
+
+} // namespace torch_points
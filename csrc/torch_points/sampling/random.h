@@ -0,0 +1,40 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// uniform random sampling without replacement
+//
+// points:     float (N,3)
+// offsets:    optional int (B+1): points offsets[b]:offsets[b+1] are the sample b
+// counts:     int (1) or (B): number of points selected in each sample
+// seed:       seed of the random generators, the result only depends on the
+//             seed and not on the number of threads
+// attributes: tensors of size (N,...) gathered with the points
+//
+// returns
+//      indices:    long (M): indices in points, in random order in each sample,
+//                  the counts[0] first ones are in the sample 0, etc
+//      points:     float (M,3)
+//      attributes: tensors of size (M,...)
+//
+// without allocation of size N: Floyd's algorithm is used when few points
+// are selected, otherwise a sequential selection in one pass over the indices
+//
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> sample_points_random(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    torch::Tensor counts,
+    int64_t seed,
+    std::vector<torch::Tensor> attributes);
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> sample_points_random_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> offsets,
+    torch::Tensor counts,
+    int64_t seed,
+    std::vector<torch::Tensor> attributes);
+
+} // namespace torch_points
@@ -0,0 +1,264 @@
+#include <torch_points/sampling/voxel.h>
+#include <torch_points/spatial/internal/box.h>
+#include <torch_points/common/hash.h>
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+#include <atomic>
+
+namespace torch_points {
+
+namespace {
+
+// number of bits to store values in [0,n)
+int bit_count(int64_t n)
+{
+    int bits = 0;
+    while((int64_t(1) << bits) < n)
+        ++bits;
+    return bits;
+}
+
+template<typename T>
+void atomic_min(std::atomic<T>& a, T value)
+{
+    T old = a.load(std::memory_order_relaxed);
+    while(value < old and not a.compare_exchange_weak(old, value, std::memory_order_relaxed));
+}
+
+//
+// concurrent hash table of the occupied voxels, open addressing with linear
+// probing on 64-bit keys, each slot also keeps the first point of its voxel
+//
+class VoxelTable
+{
+public:
+    static constexpr uint64_t Empty = ~uint64_t(0);
+
+    // the capacity is a power of two holding at least count keys at load 2/3
+    VoxelTable(int64_t count)
+    {
+        m_capacity = 2;
+        while(m_capacity < count + count / 2 + 1)
+            m_capacity *= 2;
+        TORCH_CHECK(m_capacity <= std::numeric_limits<int>::max(), "too many points");
+        m_mask = m_capacity - 1;
+        m_keys.reset(new std::atomic<uint64_t>[m_capacity]);
+        m_firsts.reset(new std::atomic<int>[m_capacity]);
+        at::parallel_for(0, m_capacity, 16384, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t s = begin; s < end; ++s) {
+                m_keys[s].store(Empty, std::memory_order_relaxed);
+                m_firsts[s].store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // slot of the voxel of the point i
+    int insert(uint64_t key, int i)
+    {
+        int64_t s = hash64(0, key) & m_mask;
+        while(true)
+        {
+            uint64_t k = m_keys[s].load(std::memory_order_relaxed);
+            if(k == Empty and m_keys[s].compare_exchange_strong(k, key, std::memory_order_relaxed))
+                k = key;
+            if(k == key) {
+                atomic_min(m_firsts[s], i);
+                return s;
+            }
+            s = (s + 1) & m_mask;
+        }
+    }
+
+    //
+    // numbers the voxels in the order of their first point by a prefix sum over
+    // the points, so the result does not depend on the insertion order
+    // the slots of the points are replaced by their voxel, firsts (V) is the
+    // first point of each voxel, the table is released
+    //
+    void number(int* slots, int N, std::vector<int>& firsts)
+    {
+        const int64_t T = std::max<int64_t>(1, std::min<int64_t>(at::get_num_threads(), N / 16384));
+        const int64_t chunk = (N + T - 1) / T;
+        const auto is_first = [&](int64_t i) {
+            return m_firsts[slots[i]].load(std::memory_order_relaxed) == i;
+        };
+        std::vector<int> counts(T + 1, 0);
+        at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+        {
+            for(int64_t t = t_begin; t < t_end; ++t)
+                for(int64_t i = t * chunk; i < std::min<int64_t>(N, (t+1) * chunk); ++i)
+                    counts[t+1] += is_first(i);
+        });
+        for(int64_t t = 0; t < T; ++t)
+            counts[t+1] += counts[t];
+
+        // the voxel is written over the key, which is not needed anymore
+        firsts.resize(counts[T]);
+        at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+        {
+            for(int64_t t = t_begin; t < t_end; ++t)
+            {
+                int v = counts[t];
+                for(int64_t i = t * chunk; i < std::min<int64_t>(N, (t+1) * chunk); ++i)
+                    if(is_first(i)) {
+                        m_keys[slots[i]].store(v, std::memory_order_relaxed);
+                        firsts[v++] = i;
+                    }
+            }
+        });
+        at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t i = begin; i < end; ++i)
+                slots[i] = m_keys[slots[i]].load(std::memory_order_relaxed);
+        });
+        m_keys.reset();
+        m_firsts.reset();
+    }
+
+protected:
+    int64_t m_capacity;
+    int64_t m_mask;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_keys;
+    std::unique_ptr<std::atomic<int>[]> m_firsts;
+};
+
+} // anonymous namespace
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> voxel_downsample(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    float voxel_size,
+    const std::string& mode)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    if(features.has_value()) {
+        CHECK_CONTIGUOUS(*features);
+        TORCH_CHECK(features->dim() == 2 and features->size(0) == points.size(0), 
+            "features must have size [N,C]");
+        TORCH_CHECK(features->scalar_type() == torch::kFloat32, "features must be float");
+    }
+    TORCH_CHECK(0 < voxel_size, "voxel_size must be positive");
+    TORCH_CHECK(mode == "mean" or mode == "first" or mode == "nearest", 
+        "mode must be 'mean', 'first' or 'nearest'");
+    DISPATCH(points.device(), voxel_downsample, 
+        points, features, voxel_size, mode);
+}
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> voxel_downsample_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    float voxel_size,
+    const std::string& mode)
+{
+    CHECK_CPU(points);
+    if(features.has_value())
+        CHECK_CPU(*features);
+    const int N = points.size(0);
+    const int C = features.has_value() ? features->size(1) : 0;
+    const float* points_ptr = points.data_ptr<float>();
+    const float* features_ptr = features.has_value() ? features->data_ptr<float>() : nullptr;
+
+    // 1. linear voxel index of each point, at most min(N, voxels) are occupied
+    const internal::Box box = N == 0 ? internal::Box{{0,0,0},{0,0,0}} : internal::bounding_box(points_ptr, N);
+    int64_t n[3];
+    int shifts[4] = {0};
+    double voxels = 1;
+    for(int d = 0; d < 3; ++d) {
+        n[d] = 1 + static_cast<int64_t>(std::floor((double(box.max[d]) - box.min[d]) / voxel_size));
+        shifts[d+1] = shifts[d] + bit_count(n[d]);
+        voxels *= n[d];
+    }
+    TORCH_CHECK(shifts[3] < 64, "voxel_size is too small");
+    const auto key_of = [&](const float* p) {
+        uint64_t key = 0;
+        for(int d = 0; d < 3; ++d) {
+            const int64_t c = static_cast<int64_t>((p[d] - box.min[d]) / voxel_size);
+            key |= uint64_t(std::min(std::max<int64_t>(c, 0), n[d] - 1)) << shifts[d];
+        }
+        return key;
+    };
+
+    // 2. voxel of each point, numbered in the order of their first point
+    VoxelTable table(std::min<double>(N, voxels));
+    auto inverse = torch::empty({N}, torch::kInt32);
+    int* inverse_ptr = inverse.data_ptr<int>();
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            inverse_ptr[i] = table.insert(key_of(points_ptr + 3 * i), i);
+    });
+    std::vector<int> firsts;
+    table.number(inverse_ptr, N, firsts);
+    const int V = firsts.size();
+
+    // 3. points of each voxel in increasing order, so that each voxel is reduced
+    //    in the same order whatever the number of threads
+    std::vector<int> offsets(V + 1);
+    std::vector<int> order(N);
+    counting_sort(inverse_ptr, N, V, offsets.data(), order.data());
+
+    // 4. reduce each voxel, the nearest point to the centroid goes to the first
+    //    point in case of ties
+    const bool first = mode == "first";
+    const bool nearest = mode == "nearest";
+    auto out_points = torch::empty({V,3}, torch::kFloat32);
+    auto out_features = torch::empty({V,C}, torch::kFloat32);
+    float* out_points_ptr = out_points.data_ptr<float>();
+    float* out_features_ptr = out_features.data_ptr<float>();
+    at::parallel_for(0, V, 1024, [&](int64_t v_begin, int64_t v_end)
+    {
+        std::vector<double> sums(C);
+        for(int64_t v = v_begin; v < v_end; ++v)
+        {
+            const int begin = offsets[v];
+            const int end = offsets[v+1];
+            const int count = end - begin;
+            double centroid[3] = {0, 0, 0};
+            std::fill(sums.begin(), sums.end(), 0.);
+            for(int k = begin; k < end; ++k)
+            {
+                const int64_t i = order[k];
+                for(int d = 0; d < 3; ++d)
+                    centroid[d] += points_ptr[3*i+d];
+                for(int c = 0; c < C; ++c)
+                    sums[c] += features_ptr[i*C+c];
+            }
+            for(int c = 0; c < C; ++c)
+                out_features_ptr[v*C+c] = sums[c] / count;
+            float c[3];
+            for(int d = 0; d < 3; ++d)
+                c[d] = centroid[d] / count;
+
+            int64_t selected = firsts[v];
+            if(nearest)
+            {
+                float best = INFINITY;
+                for(int k = begin; k < end; ++k)
+                {
+                    const int64_t i = order[k];
+                    float d2 = 0;
+                    for(int d = 0; d < 3; ++d) {
+                        const float e = points_ptr[3*i+d] - c[d];
+                        d2 += e * e;
+                    }
+                    if(d2 < best) {
+                        best = d2;
+                        selected = i;
+                    }
+                }
+            }
+            for(int d = 0; d < 3; ++d)
+                out_points_ptr[3*v+d] = first or nearest ? points_ptr[3*selected+d] : c[d];
+        }
+    });
+
+    return std::make_tuple(out_points, 
+        features.has_value() ? torch::optional<torch::Tensor>(out_features) : torch::nullopt, 
+        inverse);
+}
+
+} // namespace torch_points
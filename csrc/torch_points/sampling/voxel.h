@@ -0,0 +1,39 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// voxel grid downsampling, one output point per occupied voxel
+//
+// points:   float (N,3)
+// features: optional float (N,C)
+// mode:     "mean":    the output point is the centroid of the voxel
+//           "first":   the output point is the first point of the voxel
+//           "nearest": the output point is the point nearest to the centroid
+//
+// returns
+//      points:   float (V,3)
+//      features: float (V,C): mean features of the voxel
+//      inverse:  int (N):     voxel of each point
+//
+// the occupied voxels are found in one parallel pass with a concurrent hash
+// table of their linear indices and numbered in the order of their first
+// point, the points are then grouped by voxel with a counting sort and each
+// voxel is reduced in the order of its points, so the results do not depend
+// on the number of threads
+//
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> voxel_downsample(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    float voxel_size,
+    const std::string& mode = "mean");
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor> voxel_downsample_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    float voxel_size,
+    const std::string& mode = "mean");
+
+} // namespace torch_points
@@ -0,0 +1,141 @@
+#include <torch_points/segmentation/clusters.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+#include <atomic>
+
+namespace torch_points {
+
+namespace {
+
+//
+// lock-free union-find, roots are linked by compare-and-swap toward the
+// smaller index, so the root of a set is its smallest element
+// find() compresses the paths by halving, which is safe concurrently since it
+// only replaces a parent by one of its ancestors
+//
+class UnionFind
+{
+public:
+    UnionFind(int n) : m_parent(n)
+    {
+        at::parallel_for(0, n, 16384, [&](int64_t begin, int64_t end)
+        {
+            for(int64_t i = begin; i < end; ++i)
+                m_parent[i].store(i, std::memory_order_relaxed);
+        });
+    }
+
+    int find(int i)
+    {
+        while(true)
+        {
+            int parent = m_parent[i].load(std::memory_order_relaxed);
+            if(parent == i)
+                return i;
+            const int grandparent = m_parent[parent].load(std::memory_order_relaxed);
+            if(parent != grandparent)
+                m_parent[i].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            i = grandparent;
+        }
+    }
+
+    void unite(int i, int j)
+    {
+        while(true)
+        {
+            i = find(i);
+            j = find(j);
+            if(i == j)
+                return;
+            if(i < j)
+                std::swap(i, j);
+            // i may have been linked by another thread since find(i), then retry
+            int expected = i;
+            if(m_parent[i].compare_exchange_strong(expected, j, std::memory_order_relaxed))
+                return;
+        }
+    }
+
+protected:
+    std::vector<std::atomic<int>> m_parent;
+};
+
+} // anonymous namespace
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> euclidean_clusters(
+    torch::Tensor points,
+    float d,
+    int min_size)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 <= d, "d must be non-negative");
+    DISPATCH(points.device(), euclidean_clusters, points, d, min_size);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> euclidean_clusters_cpu(
+    torch::Tensor points,
+    float d,
+    int min_size)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+
+    // 1. link the pairs of points at distance at most d
+    internal::Grid3D grid;
+    grid.build(points_ptr, 0, N, d);
+    UnionFind sets(N);
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            grid.for_each_in_radius(points_ptr + 3 * i, d, [&](int j, float) {
+                if(i < j)
+                    sets.unite(i, j);
+            });
+        }
+    });
+
+    // 2. clusters numbered in the order of their roots
+    std::vector<int> roots(N);
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            roots[i] = sets.find(i);
+    });
+    std::vector<int> sizes(N, 0);
+    for(int i = 0; i < N; ++i)
+        ++sizes[roots[i]];
+    std::vector<int> cluster(N, -1);
+    int K = 0;
+    for(int i = 0; i < N; ++i)
+        if(roots[i] == i and min_size <= sizes[i])
+            cluster[i] = K++;
+
+    auto labels = torch::empty({N}, torch::kInt32);
+    int* labels_ptr = labels.data_ptr<int>();
+    std::vector<int> keys(N);
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i) {
+            labels_ptr[i] = cluster[roots[i]];
+            keys[i] = labels_ptr[i] < 0 ? K : labels_ptr[i];
+        }
+    });
+
+    // 3. CSR membership, the points of the small components are in the last bucket
+    std::vector<int> offsets(K + 2);
+    std::vector<int> order(N);
+    counting_sort(keys.data(), N, K + 1, offsets.data(), order.data());
+    auto offsets_tensor = torch::empty({K + 1}, torch::kInt32);
+    auto indices = torch::empty({offsets[K]}, torch::kInt32);
+    std::copy(offsets.begin(), offsets.begin() + K + 1, offsets_tensor.data_ptr<int>());
+    std::copy(order.begin(), order.begin() + offsets[K], indices.data_ptr<int>());
+    return std::make_tuple(labels, offsets_tensor, indices);
+}
+
+} // namespace torch_points
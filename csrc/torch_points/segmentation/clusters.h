@@ -0,0 +1,33 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// euclidean clustering: connected components of the graph linking the points
+// at distance at most d
+//
+// points: float (N,3)
+//
+// returns
+//      labels:  int (N):   cluster of each point, -1 if its component has less
+//                          than min_size points, clusters are ordered by their
+//                          smallest point index
+//      offsets: int (K+1): points indices[offsets[k]:offsets[k+1]] are the cluster k
+//      indices: int (P):   indices of the points of the clusters, in increasing order
+//
+// points are binned in a uniform 3D grid of cell size at least d, the pairs of
+// neighboring points are linked in parallel by a lock-free union-find
+//
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> euclidean_clusters(
+    torch::Tensor points,
+    float d,
+    int min_size);
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> euclidean_clusters_cpu(
+    torch::Tensor points,
+    float d,
+    int min_size);
+
+} // namespace torch_points
@@ -0,0 +1,75 @@
+#include <torch_points/spatial/ball_query.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+namespace torch_points {
+
+std::pair<torch::Tensor,torch::Tensor> ball_query(
+    torch::Tensor points,
+    torch::Tensor centroids,
+    float r,
+    int K)
+{
+    CHECK_CONTIGUOUS(points);
+    CHECK_CONTIGUOUS(centroids);
+    TORCH_CHECK(points.dim() == centroids.dim(), "points and centroids must have the same number of dimensions");
+    TORCH_CHECK((points.dim() == 2 or points.dim() == 3) and points.size(-1) == 3, 
+        "points must have size [N,3] or [B,N,3]");
+    TORCH_CHECK(centroids.size(-1) == 3, "centroids must have size [M,3] or [B,M,3]");
+    TORCH_CHECK(points.dim() == 2 or points.size(0) == centroids.size(0), 
+        "points and centroids must have the same batch size");
+    TORCH_CHECK(0 <= r, "r must be non-negative");
+    TORCH_CHECK(0 < K, "K must be positive");
+    DISPATCH(points.device(), ball_query, points, centroids, r, K);
+}
+
+std::pair<torch::Tensor,torch::Tensor> ball_query_cpu(
+    torch::Tensor points,
+    torch::Tensor centroids,
+    float r,
+    int K)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(centroids);
+    const bool batched = points.dim() == 3;
+    const int B = batched ? points.size(0) : 1;
+    const int N = points.size(-2);
+    const int M = centroids.size(-2);
+    const float* points_ptr = points.data_ptr<float>();
+    const float* centroids_ptr = centroids.data_ptr<float>();
+
+    std::vector<int> offsets(B + 1);
+    for(int b = 0; b <= B; ++b)
+        offsets[b] = b * N;
+    const auto grids = internal::build_grids(points_ptr, offsets, r);
+
+    auto indices = torch::empty({B,M,K}, torch::kInt32);
+    auto counts = torch::empty({B,M}, torch::kInt32);
+    int* indices_ptr = indices.data_ptr<int>();
+    int* counts_ptr = counts.data_ptr<int>();
+    std::vector<float> d2(int64_t(B) * M * K);
+
+    // the heap writes directly into the output rows
+    at::parallel_for(0, int64_t(B) * M, 64, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            const int b = i / M;
+            int* idx = indices_ptr + i * K;
+            internal::KnnHeap heap(idx, d2.data() + i * K, K, r * r);
+            grids[b].search(centroids_ptr + 3 * i, heap);
+            const int count = heap.sort();
+            for(int j = 0; j < count; ++j)
+                idx[j] -= b * N;
+            std::fill(idx + count, idx + K, count == 0 ? -1 : idx[0]);
+            counts_ptr[i] = count;
+        }
+    });
+
+    if(not batched)
+        return std::make_pair(indices[0], counts[0]);
+    return std::make_pair(indices, counts);
+}
+
+} // namespace torch_points
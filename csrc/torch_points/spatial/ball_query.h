@@ -0,0 +1,31 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// PointNet++ grouping: neighbors of each centroid within distance r
+//
+// points:    float (N,3) or (B,N,3)
+// centroids: float (M,3) or (B,M,3)
+//
+// returns
+//      indices: int (M,K) or (B,M,K): the K nearest points within r sorted by
+//               distance, indices in the points of the same sample, padded by
+//               repeating the first one, -1 if there is none
+//      counts:  int (M) or (B,M):     number of neighbors found
+//
+std::pair<torch::Tensor,torch::Tensor> ball_query(
+    torch::Tensor points,
+    torch::Tensor centroids,
+    float r,
+    int K);
+
+std::pair<torch::Tensor,torch::Tensor> ball_query_cpu(
+    torch::Tensor points,
+    torch::Tensor centroids,
+    float r,
+    int K);
+
+} // namespace torch_points
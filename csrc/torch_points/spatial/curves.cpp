@@ -0,0 +1,169 @@
+#include <torch_points/spatial/curves.h>
+#include <torch_points/spatial/internal/box.h>
+#include <torch_points/spatial/internal/morton.h>
+#include <torch_points/spatial/internal/hilbert.h>
+#include <torch_points/common/radix_sort.h>
+#include <torch_points/common/gather.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+
+namespace torch_points {
+
+namespace {
+
+void check_curve(torch::Tensor points, torch::optional<torch::Tensor> bounds, int bits)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    if(bounds.has_value())
+        TORCH_CHECK(bounds->numel() == 6, "bounds must have size [6]");
+    TORCH_CHECK(1 <= bits and bits <= internal::Morton<3>::max_bits, 
+        "bits must be in [1,", internal::Morton<3>::max_bits, "]");
+}
+
+//
+// codes[i] = encode(q, bits) for the quantized coordinates q of each point
+// encode is called in parallel over the points
+//
+template<typename EncodeT>
+void encode_points(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    uint64_t* codes,
+    const EncodeT& encode)
+{
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    internal::Box box = N == 0 ? internal::Box{{0,0,0},{0,0,0}} : internal::bounding_box(points_ptr, N);
+    if(bounds.has_value())
+    {
+        const auto bounds_float = bounds->to(torch::kFloat32).contiguous();
+        const float* b = bounds_float.data_ptr<float>();
+        for(int d = 0; d < 3; ++d) {
+            box.min[d] = b[2*d+0];
+            box.max[d] = b[2*d+1];
+        }
+    }
+    const int64_t cells = int64_t(1) << bits;
+    double scale[3];
+    for(int d = 0; d < 3; ++d) {
+        const double extent = double(box.max[d]) - box.min[d];
+        scale[d] = 0 < extent ? cells / extent : 0;
+    }
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            uint32_t q[3];
+            for(int d = 0; d < 3; ++d) {
+                const int64_t c = static_cast<int64_t>(std::floor((points_ptr[3*i+d] - box.min[d]) * scale[d]));
+                q[d] = std::min(std::max<int64_t>(c, 0), cells - 1);
+            }
+            codes[i] = encode(q);
+        }
+    });
+}
+
+torch::Tensor encode_tensor(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    bool hilbert)
+{
+    auto codes = torch::empty({points.size(0)}, torch::kInt64);
+    uint64_t* codes_ptr = reinterpret_cast<uint64_t*>(codes.data_ptr<int64_t>());
+    if(hilbert)
+        encode_points(points, bounds, bits, codes_ptr, [bits](const uint32_t* q) { 
+            return internal::Hilbert<3>::encode(q, bits); 
+        });
+    else
+        encode_points(points, bounds, bits, codes_ptr, [](const uint32_t* q) { 
+            return internal::Morton<3>::encode(q); 
+        });
+    return codes;
+}
+
+} // anonymous namespace
+
+torch::Tensor morton_encode(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits)
+{
+    check_curve(points, bounds, bits);
+    DISPATCH(points.device(), morton_encode, points, bounds, bits);
+}
+
+torch::Tensor morton_encode_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits)
+{
+    CHECK_CPU(points);
+    return encode_tensor(points, bounds, bits, false);
+}
+
+torch::Tensor hilbert_encode(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits)
+{
+    check_curve(points, bounds, bits);
+    DISPATCH(points.device(), hilbert_encode, points, bounds, bits);
+}
+
+torch::Tensor hilbert_encode_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits)
+{
+    CHECK_CPU(points);
+    return encode_tensor(points, bounds, bits, true);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> spatial_sort(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    const std::string& curve,
+    std::vector<torch::Tensor> attributes)
+{
+    check_curve(points, bounds, bits);
+    TORCH_CHECK(curve == "morton" or curve == "hilbert", "curve must be 'morton' or 'hilbert'");
+    for(const auto& attribute : attributes) {
+        CHECK_CONTIGUOUS(attribute);
+        TORCH_CHECK(1 <= attribute.dim() and attribute.size(0) == points.size(0), 
+            "attributes must have size [N,...]");
+    }
+    DISPATCH(points.device(), spatial_sort, points, bounds, bits, curve, attributes);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> spatial_sort_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    const std::string& curve,
+    std::vector<torch::Tensor> attributes)
+{
+    CHECK_CPU(points);
+    for(const auto& attribute : attributes)
+        CHECK_CPU(attribute);
+    const int N = points.size(0);
+    const auto codes = encode_tensor(points, bounds, bits, curve == "hilbert");
+    std::vector<uint64_t> sorted_codes(N);
+    std::vector<int> order(N);
+    radix_sort(
+        reinterpret_cast<const uint64_t*>(codes.data_ptr<int64_t>()), 
+        N, 3 * bits, sorted_codes.data(), order.data());
+
+    auto permutation = torch::empty({N}, torch::kInt64);
+    std::copy(order.begin(), order.end(), permutation.data_ptr<int64_t>());
+    std::vector<torch::Tensor> sorted_attributes;
+    sorted_attributes.reserve(attributes.size());
+    for(const auto& attribute : attributes)
+        sorted_attributes.push_back(gather_rows(attribute, order.data(), N));
+    return std::make_tuple(permutation, gather_rows(points, order.data(), N), sorted_attributes);
+}
+
+} // namespace torch_points
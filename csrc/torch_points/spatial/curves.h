@@ -0,0 +1,62 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// space-filling curve codes of 3D points
+//
+// bounds: optional float (6): xmin/xmax/ymin/ymax/zmin/zmax, bounding box of
+//         the points by default, points outside are clamped
+// bits:   bits per axis in [1,21], coordinates are quantized in [0,2^bits)
+//
+// returns
+//      codes: long (N)
+//
+torch::Tensor morton_encode(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits = 21);
+
+torch::Tensor morton_encode_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits = 21);
+
+torch::Tensor hilbert_encode(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits = 21);
+
+torch::Tensor hilbert_encode_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits = 21);
+
+//
+// reorder points along a space-filling curve ("morton" or "hilbert")
+// codes are sorted by a parallel radix sort on 3*bits bits, the order is stable
+//
+// attributes: tensors of size (N,...) reordered with the points
+//
+// returns
+//      permutation: long (N): indices in points in curve order
+//      points:      float (N,3)
+//      attributes:  tensors of size (N,...)
+//
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> spatial_sort(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    const std::string& curve,
+    std::vector<torch::Tensor> attributes);
+
+std::tuple<torch::Tensor,torch::Tensor,std::vector<torch::Tensor>> spatial_sort_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> bounds,
+    int bits,
+    const std::string& curve,
+    std::vector<torch::Tensor> attributes);
+
+} // namespace torch_points
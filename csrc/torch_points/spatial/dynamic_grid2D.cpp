@@ -0,0 +1,339 @@
+#include <torch_points/spatial/dynamic_grid2D.h>
+#include <torch_points/spatial/internal/cell.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+
+namespace torch_points {
+
+namespace {
+
+// consecutive entries of a (cell,id) list sorted by cell
+struct Group
+{
+    int cell;
+    int first;
+    int count;
+    int old_begin; // -1 if the cell is not moved
+};
+
+std::vector<Group> make_groups(const std::vector<std::pair<int,int>>& items)
+{
+    std::vector<Group> groups;
+    const int M = items.size();
+    for(int i = 0; i < M; ++i)
+    {
+        if(groups.empty() or groups.back().cell != items[i].first)
+            groups.push_back({items[i].first, i, 0, -1});
+        ++groups.back().count;
+    }
+    return groups;
+}
+
+} // anonymous namespace
+
+DynamicGrid2D::DynamicGrid2D(
+    float xmin,
+    float xmax,
+    float ymin,
+    float ymax,
+    int Nx,
+    int Ny,
+    int slack) :
+    m_xmin(xmin),
+    m_xmax(xmax),
+    m_ymin(ymin),
+    m_ymax(ymax),
+    m_Nx(Nx),
+    m_Ny(Ny),
+    m_dx((xmax - xmin) / Nx),
+    m_dy((ymax - ymin) / Ny),
+    m_slack(slack),
+    m_cells(torch::zeros({Nx,Ny,2}, torch::kInt32)),
+    m_indices(torch::empty({0}, torch::kInt32)),
+    m_points(torch::empty({0,3}, torch::kFloat32)),
+    m_capacities(Nx * Ny, 0),
+    m_tail(0),
+    m_garbage(0),
+    m_cell_of(),
+    m_slot_of(),
+    m_free_ids(),
+    m_id_count(0)
+{
+    TORCH_CHECK(0 < Nx);
+    TORCH_CHECK(0 < Ny);
+    TORCH_CHECK(xmin < xmax);
+    TORCH_CHECK(ymin < ymax);
+    TORCH_CHECK(0 < slack);
+}
+
+torch::Tensor DynamicGrid2D::insert(torch::Tensor points)
+{
+    CHECK_CPU(points);
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    const int M = points.size(0);
+    const auto points_acc = points.accessor<float,2>();
+
+    auto ids = torch::full({M}, -1, torch::kInt32);
+    int* ids_ptr = ids.data_ptr<int>();
+
+    // 1. find cells, the flat cell index ix*Ny+iy matches the layout of m_cells
+    std::vector<int> keys(M);
+    parallel_for(M, [&](int i)
+    {
+        const float x = points_acc[i][0];
+        const float y = points_acc[i][1];
+        if(m_xmin <= x and x < m_xmax and m_ymin <= y and y < m_ymax) {
+            const int ix = internal::cell_coord(x, m_xmin, m_dx, m_Nx);
+            const int iy = internal::cell_coord(y, m_ymin, m_dy, m_Ny);
+            keys[i] = ix * m_Ny + iy;
+        } else {
+            keys[i] = -1;
+        }
+    }, 2048);
+
+    // 2. assign ids and copy points
+    std::vector<std::pair<int,int>> items; // (cell,id)
+    items.reserve(M);
+    for(int i = 0; i < M; ++i)
+    {
+        if(keys[i] < 0)
+            continue;
+        int id;
+        if(m_free_ids.empty()) {
+            id = m_id_count++;
+        } else {
+            id = m_free_ids.back();
+            m_free_ids.pop_back();
+        }
+        ids_ptr[i] = id;
+        items.emplace_back(keys[i], id);
+    }
+    reserve_points(m_id_count);
+    m_cell_of.resize(m_id_count, -1);
+    m_slot_of.resize(m_id_count, -1);
+    {
+        float* dst = m_points.data_ptr<float>();
+        const float* src = points.data_ptr<float>();
+        parallel_for(M, [&](int i)
+        {
+            const int id = ids_ptr[i];
+            if(id < 0)
+                return;
+            dst[3*id+0] = src[3*i+0];
+            dst[3*id+1] = src[3*i+1];
+            dst[3*id+2] = src[3*i+2];
+            m_cell_of[id] = keys[i];
+        }, 2048);
+    }
+
+    // 3. group by cell and move full cells to the end of the buffer
+    std::sort(items.begin(), items.end());
+    std::vector<Group> groups = make_groups(items);
+    int* cells_ptr = m_cells.data_ptr<int>();
+    int tail = m_tail;
+    for(auto& g : groups)
+    {
+        const int begin = cells_ptr[2*g.cell+0];
+        const int end   = cells_ptr[2*g.cell+1];
+        const int size  = end - begin;
+        if(m_capacities[g.cell] < size + g.count)
+        {
+            g.old_begin = begin;
+            m_garbage += m_capacities[g.cell];
+            m_capacities[g.cell] = std::max(m_slack, 2 * (size + g.count));
+            tail += m_capacities[g.cell];
+        }
+    }
+    reserve_indices(tail);
+
+    // 4. fill cells in parallel, each group owns a disjoint range
+    int* indices_ptr = m_indices.data_ptr<int>();
+    std::vector<int> new_begins(groups.size());
+    {
+        int offset = m_tail;
+        for(int k = 0; k < int(groups.size()); ++k)
+        {
+            new_begins[k] = offset;
+            if(0 <= groups[k].old_begin)
+                offset += m_capacities[groups[k].cell];
+        }
+    }
+    m_tail = tail;
+    parallel_for(groups.size(), [&](int k)
+    {
+        const Group& g = groups[k];
+        int& begin = cells_ptr[2*g.cell+0];
+        int& end   = cells_ptr[2*g.cell+1];
+        if(0 <= g.old_begin)
+        {
+            const int size = end - begin;
+            std::copy(
+                indices_ptr + begin,
+                indices_ptr + end,
+                indices_ptr + new_begins[k]);
+            begin = new_begins[k];
+            end = begin + size;
+            for(int i = begin; i < end; ++i)
+                m_slot_of[indices_ptr[i]] = i;
+        }
+        for(int i = g.first; i < g.first + g.count; ++i)
+        {
+            const int id = items[i].second;
+            indices_ptr[end] = id;
+            m_slot_of[id] = end;
+            ++end;
+        }
+    });
+
+    maybe_compact();
+    return ids;
+}
+
+void DynamicGrid2D::remove(torch::Tensor ids)
+{
+    CHECK_CPU(ids);
+    CHECK_CONTIGUOUS(ids);
+    TORCH_CHECK(ids.dim() == 1, "ids must have size [M]");
+    const int M = ids.size(0);
+    const int* ids_ptr = ids.data_ptr<int>();
+
+    // 1. check and detach ids, the whole batch is validated before any change
+    for(int i = 0; i < M; ++i)
+    {
+        const int id = ids_ptr[i];
+        TORCH_CHECK(0 <= id and id < m_id_count, "invalid point id ", id);
+        TORCH_CHECK(0 <= m_cell_of[id], "point ", id, " is not in the grid");
+    }
+    std::vector<std::pair<int,int>> items; // (cell,id)
+    items.reserve(M);
+    for(int i = 0; i < M; ++i)
+    {
+        const int id = ids_ptr[i];
+        if(m_cell_of[id] < 0)
+            continue; // already removed or duplicated
+        items.emplace_back(m_cell_of[id], id);
+        m_cell_of[id] = -1;
+        m_free_ids.push_back(id);
+    }
+
+    // 2. swap with the last point of the cell
+    std::sort(items.begin(), items.end());
+    const std::vector<Group> groups = make_groups(items);
+    int* cells_ptr = m_cells.data_ptr<int>();
+    int* indices_ptr = m_indices.data_ptr<int>();
+    parallel_for(groups.size(), [&](int k)
+    {
+        const Group& g = groups[k];
+        int& end = cells_ptr[2*g.cell+1];
+        for(int i = g.first; i < g.first + g.count; ++i)
+        {
+            const int id = items[i].second;
+            const int slot = m_slot_of[id];
+            const int last = indices_ptr[end-1];
+            indices_ptr[slot] = last;
+            m_slot_of[last] = slot;
+            m_slot_of[id] = -1;
+            --end;
+        }
+    });
+}
+
+void DynamicGrid2D::compact()
+{
+    const int C = m_Nx * m_Ny;
+    int* cells_ptr = m_cells.data_ptr<int>();
+
+    // new capacities keep a quarter of slack
+    std::vector<int> new_begins(C);
+    int total = 0;
+    for(int c = 0; c < C; ++c)
+    {
+        const int size = cells_ptr[2*c+1] - cells_ptr[2*c+0];
+        new_begins[c] = total;
+        m_capacities[c] = size == 0 ? 0 : size + std::max(m_slack, size / 4);
+        total += m_capacities[c];
+    }
+
+    auto indices = torch::empty({std::max(total, 1)}, torch::kInt32);
+    const int* src = m_indices.data_ptr<int>();
+    int* dst = indices.data_ptr<int>();
+    parallel_for(C, [&](int c)
+    {
+        const int begin = cells_ptr[2*c+0];
+        const int end   = cells_ptr[2*c+1];
+        const int new_begin = new_begins[c];
+        for(int i = begin; i < end; ++i)
+        {
+            const int id = src[i];
+            dst[new_begin + i - begin] = id;
+            m_slot_of[id] = new_begin + i - begin;
+        }
+        cells_ptr[2*c+0] = new_begin;
+        cells_ptr[2*c+1] = new_begin + end - begin;
+    }, 256);
+
+    m_indices = indices;
+    m_tail = total;
+    m_garbage = 0;
+}
+
+torch::Tensor DynamicGrid2D::cells() const
+{
+    return m_cells;
+}
+
+torch::Tensor DynamicGrid2D::indices() const
+{
+    return m_indices.narrow(0, 0, m_tail);
+}
+
+torch::Tensor DynamicGrid2D::points() const
+{
+    return m_points.narrow(0, 0, m_id_count);
+}
+
+int DynamicGrid2D::size() const
+{
+    return m_id_count - m_free_ids.size();
+}
+
+int DynamicGrid2D::garbage() const
+{
+    return m_garbage;
+}
+
+void DynamicGrid2D::reserve_indices(int capacity)
+{
+    const int current = m_indices.size(0);
+    if(capacity <= current)
+        return;
+    auto indices = torch::empty({std::max(capacity, 2 * current)}, torch::kInt32);
+    std::copy(
+        m_indices.data_ptr<int>(),
+        m_indices.data_ptr<int>() + m_tail,
+        indices.data_ptr<int>());
+    m_indices = indices;
+}
+
+void DynamicGrid2D::reserve_points(int capacity)
+{
+    const int current = m_points.size(0);
+    if(capacity <= current)
+        return;
+    auto points = torch::empty({std::max(capacity, 2 * current),3}, torch::kFloat32);
+    std::copy(
+        m_points.data_ptr<float>(),
+        m_points.data_ptr<float>() + 3 * current,
+        points.data_ptr<float>());
+    m_points = points;
+}
+
+// holes are reclaimed once they are the larger part of the buffer
+void DynamicGrid2D::maybe_compact()
+{
+    if(m_tail < 2 * m_garbage and (1 << 16) < m_garbage)
+        compact();
+}
+
+} // namespace torch_points
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// mutable 2D grid with the same cell semantics as build_grid2d
+//
+// points are copied into the grid and identified by int ids (reused after removal)
+// each cell owns a slice of the indices buffer with some slack capacity,
+// a full cell is moved to the end of the buffer with twice its size
+// the holes left behind are reclaimed by compact()
+//
+// cells:   int (Nx,Ny,2): begin/end indices
+// indices: int (L):       ids of points, only [begin,end) of each cell is valid
+// points:  float (P,3):   points indexed by ids
+//
+// cells/indices/points share memory with the grid
+// they are invalidated by the next insert/remove/compact
+//
+class DynamicGrid2D
+{
+public:
+    DynamicGrid2D(
+        float xmin,
+        float xmax,
+        float ymin,
+        float ymax,
+        int Nx,
+        int Ny,
+        int slack = 4);
+
+    // returns int (M): ids of the inserted points, -1 for points out of the grid
+    torch::Tensor insert(torch::Tensor points);
+
+    // ids must refer to points in the grid, duplicates are ignored
+    void remove(torch::Tensor ids);
+
+    // reallocate the indices buffer without holes
+    void compact();
+
+    torch::Tensor cells() const;
+    torch::Tensor indices() const;
+    torch::Tensor points() const;
+
+    int size() const;
+    int garbage() const;
+
+protected:
+    void reserve_indices(int capacity);
+    void reserve_points(int capacity);
+    void maybe_compact();
+
+protected:
+    float m_xmin;
+    float m_xmax;
+    float m_ymin;
+    float m_ymax;
+    int m_Nx;
+    int m_Ny;
+    float m_dx;
+    float m_dy;
+    int m_slack;
+
+    torch::Tensor m_cells;          // int (Nx,Ny,2)
+    torch::Tensor m_indices;        // int (capacity)
+    torch::Tensor m_points;         // float (capacity,3)
+    std::vector<int> m_capacities;  // per cell
+    int m_tail;                     // used part of m_indices
+    int m_garbage;                  // holes in m_indices
+
+    std::vector<int> m_cell_of;     // per id, -1 if free
+    std::vector<int> m_slot_of;     // per id, position in m_indices
+    std::vector<int> m_free_ids;
+    int m_id_count;                 // ids in [0,m_id_count) have been used
+};
+
+} // namespace torch_points
@@ -0,0 +1,222 @@
+#include <torch_points/spatial/graph.h>
+#include <torch_points/spatial/internal/grid3D.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+#include <torch_points/common/batch.h>
+
+namespace torch_points {
+
+namespace {
+
+//
+// two-pass edge construction
+// count(i) returns the number of edges of the target i
+// write(i, sources) writes the sources of the target i
+//
+template<typename CountT, typename WriteT>
+torch::Tensor make_edges(int N, const CountT& count, const WriteT& write)
+{
+    std::vector<int64_t> offsets(N + 1, 0);
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            offsets[i+1] = count(i);
+    });
+    for(int i = 0; i < N; ++i)
+        offsets[i+1] += offsets[i];
+    const int64_t E = offsets[N];
+    auto edge_index = torch::empty({2,E}, torch::kInt64);
+    int64_t* sources = edge_index.data_ptr<int64_t>();
+    int64_t* targets = sources + E;
+    at::parallel_for(0, N, 256, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i) {
+            write(i, sources + offsets[i]);
+            std::fill(targets + offsets[i], targets + offsets[i+1], i);
+        }
+    });
+    return edge_index;
+}
+
+// union of the edges and the reversed edges, sorted by target and source
+torch::Tensor symmetrize(torch::Tensor edge_index, int N)
+{
+    const int64_t E = edge_index.size(1);
+    const int64_t* sources = edge_index.data_ptr<int64_t>();
+    const int64_t* targets = sources + E;
+    TORCH_CHECK(2 * E < std::numeric_limits<int>::max(), "too many edges");
+
+    // both directions grouped by target
+    std::vector<int> keys(2 * E);
+    std::vector<int> order(2 * E);
+    std::vector<int> offsets(N + 1);
+    at::parallel_for(0, E, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t e = begin; e < end; ++e) {
+            keys[e]     = targets[e];
+            keys[E + e] = sources[e];
+        }
+    });
+    counting_sort(keys.data(), 2 * E, N, offsets.data(), order.data());
+
+    // sorted unique sources of each target
+    std::vector<int> counts(N);
+    std::vector<int> neighbors(2 * E);
+    parallel_for(N, [&](int i)
+    {
+        int* first = neighbors.data() + offsets[i];
+        int* last = neighbors.data() + offsets[i+1];
+        for(int* it = first; it != last; ++it) {
+            const int e = order[it - neighbors.data()];
+            *it = e < E ? sources[e] : targets[e - E];
+        }
+        std::sort(first, last);
+        counts[i] = std::unique(first, last) - first;
+    }, 256);
+
+    return make_edges(N, 
+        [&](int i) { return counts[i]; },
+        [&](int i, int64_t* out) {
+            std::copy(
+                neighbors.data() + offsets[i], 
+                neighbors.data() + offsets[i] + counts[i],
+                out);
+        });
+}
+
+} // anonymous namespace
+
+torch::Tensor knn_graph(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    int k,
+    bool loop,
+    bool symmetric)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < k, "k must be positive");
+    DISPATCH(points.device(), knn_graph, 
+        points, batch, k, loop, symmetric);
+}
+
+torch::Tensor knn_graph_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    int k,
+    bool loop,
+    bool symmetric)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const std::vector<int> offsets = batch_to_offsets(batch, N);
+    const std::vector<int> sample = offsets_to_batch(offsets);
+    const auto grids = internal::build_grids(points_ptr, offsets, 0, k);
+
+    // one more neighbor is searched to skip the point itself
+    const int K = loop ? k : k + 1;
+    const auto count = [&](int i) -> int {
+        const int b = sample[i];
+        const int n = offsets[b+1] - offsets[b];
+        return std::min(k, loop ? n : n - 1);
+    };
+    const auto write = [&](int i, int64_t* out) {
+        thread_local std::vector<int> idx;
+        thread_local std::vector<float> d2;
+        idx.resize(K);
+        d2.resize(K);
+        internal::KnnHeap heap(idx.data(), d2.data(), K);
+        grids[sample[i]].search(points_ptr + 3*i, heap);
+        const int found = heap.sort();
+        const int expected = count(i);
+        int written = 0;
+        for(int j = 0; j < found and written < expected; ++j)
+            if(loop or idx[j] != i)
+                out[written++] = idx[j];
+    };
+
+    auto edge_index = make_edges(N, count, write);
+    return symmetric ? symmetrize(edge_index, N) : edge_index;
+}
+
+torch::Tensor radius_graph(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    float r,
+    int max_neighbors,
+    bool loop,
+    bool symmetric)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 <= r, "r must be non-negative");
+    DISPATCH(points.device(), radius_graph, 
+        points, batch, r, max_neighbors, loop, symmetric);
+}
+
+torch::Tensor radius_graph_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    float r,
+    int max_neighbors,
+    bool loop,
+    bool symmetric)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+    const std::vector<int> offsets = batch_to_offsets(batch, N);
+    const std::vector<int> sample = offsets_to_batch(offsets);
+    const auto grids = internal::build_grids(points_ptr, offsets, r);
+
+    torch::Tensor edge_index;
+    if(max_neighbors <= 0)
+    {
+        // all neighbors, in the order of the grid cells
+        edge_index = make_edges(N, 
+            [&](int i) -> int {
+                int count = 0;
+                grids[sample[i]].for_each_in_radius(points_ptr + 3*i, r, [&](int j, float) {
+                    count += loop or j != i;
+                });
+                return count;
+            },
+            [&](int i, int64_t* out) {
+                grids[sample[i]].for_each_in_radius(points_ptr + 3*i, r, [&](int j, float) {
+                    if(loop or j != i)
+                        *out++ = j;
+                });
+            });
+    }
+    else
+    {
+        // nearest neighbors, one more is searched to skip the point itself
+        const int K = loop ? max_neighbors : max_neighbors + 1;
+        const auto search = [&](int i, int64_t* out) -> int {
+            thread_local std::vector<int> idx;
+            thread_local std::vector<float> d2;
+            idx.resize(K);
+            d2.resize(K);
+            internal::KnnHeap heap(idx.data(), d2.data(), K, r * r);
+            grids[sample[i]].search(points_ptr + 3*i, heap);
+            const int found = heap.sort();
+            int count = 0;
+            for(int j = 0; j < found and count < max_neighbors; ++j) {
+                if(loop or idx[j] != i) {
+                    if(out != nullptr)
+                        out[count] = idx[j];
+                    ++count;
+                }
+            }
+            return count;
+        };
+        edge_index = make_edges(N, 
+            [&](int i) { return search(i, nullptr); },
+            [&](int i, int64_t* out) { search(i, out); });
+    }
+    return symmetric ? symmetrize(edge_index, N) : edge_index;
+}
+
+} // namespace torch_points
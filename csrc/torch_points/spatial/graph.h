@@ -0,0 +1,59 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// neighborhood graphs over a batch of point clouds
+//
+// batch: optional int (N): sorted sample index of each point, 
+//        neighbors are only searched in the same sample
+//
+// returns
+//      edge_index: long (2,E): edge_index[0] are the neighbors (sources),
+//                              edge_index[1] are the query points (targets),
+//                              edges are grouped by target
+//
+// edges are counted in a first pass so that the output is allocated once
+// with its exact size, then written in a second pass
+//
+// loop:      if true, each point is its own neighbor
+// symmetric: if true, the reversed edges are added (without duplicates),
+//            edges are then sorted by target and source
+//
+
+// k nearest neighbors of each point
+torch::Tensor knn_graph(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    int k,
+    bool loop = false,
+    bool symmetric = false);
+
+torch::Tensor knn_graph_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    int k,
+    bool loop = false,
+    bool symmetric = false);
+
+// neighbors within distance r of each point, only the max_neighbors nearest
+// ones are kept unless max_neighbors <= 0
+torch::Tensor radius_graph(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    float r,
+    int max_neighbors = 32,
+    bool loop = false,
+    bool symmetric = false);
+
+torch::Tensor radius_graph_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> batch,
+    float r,
+    int max_neighbors = 32,
+    bool loop = false,
+    bool symmetric = false);
+
+} // namespace torch_points
@@ -60,4 +60,62 @@ build_grid2d_cuda(
     int Ny,
     bool sort_z = false);
 
+//
+// batched version of build_grid2d, sample b is points[offsets[b]:offsets[b+1]]
+//
+// offsets: int (B+1)
+// bounds:  float (B,4): xmin/xmax/ymin/ymax of each sample
+//
+// returns
+//      cells:   int (B,Nx,Ny,2): begin/end indices
+//      indices: int (N):         indices in points
+//
+// the indices of sample b are stored before the ones of sample b+1,
+// points out of the bounds of their sample are stored at the end
+//
+std::pair<torch::Tensor,torch::Tensor> 
+build_grid2d_batch(
+    torch::Tensor points,
+    torch::Tensor offsets,
+    torch::Tensor bounds,
+    int Nx,
+    int Ny,
+    bool sort_z = false);
+
+std::pair<torch::Tensor,torch::Tensor> 
+build_grid2d_batch_cpu(
+    torch::Tensor points,
+    torch::Tensor offsets,
+    torch::Tensor bounds,
+    int Nx,
+    int Ny,
+    bool sort_z = false);
+
+//
+// build_grid2d with bounds computed from the points
+//
+// the grid starts at the min x/y of the points and has square cells of
+// size cell_size, or of the size giving points_per_cell points per cell
+// on average (exactly one of them must be positive)
+// Nx/Ny are chosen so that all points are strictly below xmax/ymax
+//
+// returns
+//      cells:   int (Nx,Ny,2): begin/end indices
+//      indices: int (N):       indices in points
+//      bounds:  float (4):     xmin/xmax/ymin/ymax
+//
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> 
+build_grid2d_auto(
+    torch::Tensor points,
+    float cell_size,
+    float points_per_cell,
+    bool sort_z = false);
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> 
+build_grid2d_auto_cpu(
+    torch::Tensor points,
+    float cell_size,
+    float points_per_cell,
+    bool sort_z = false);
+
 } // namespace torch_points
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include <torch_points/common/dispatch.h>
 #include <torch_points/common/check.h>
 #include <torch_points/common/parallel.h>
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/spatial/internal/cell.h>
+#include <torch_points/spatial/internal/box.h>
 
 namespace torch_points {
 
@@ -145,4 +148,184 @@ build_grid2d_cpu(
     return std::make_pair(cells, indices);
 }
 
-} // namespace torch_points 
\ No newline at end of file
+std::pair<torch::Tensor,torch::Tensor> 
+build_grid2d_batch(
+    torch::Tensor points,
+    torch::Tensor offsets,
+    torch::Tensor bounds,
+    int Nx,
+    int Ny,
+    bool sort_z)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    CHECK_CONTIGUOUS(offsets);
+    CHECK_CONTIGUOUS(bounds);
+    TORCH_CHECK(offsets.dim() == 1 and 1 < offsets.size(0), "offsets must have size [B+1]");
+    TORCH_CHECK(bounds.dim() == 2 and bounds.size(0) == offsets.size(0) - 1 and bounds.size(1) == 4, 
+        "bounds must have size [B,4]");
+    TORCH_CHECK(0 < Nx);
+    TORCH_CHECK(0 < Ny);
+    DISPATCH(points.device(), build_grid2d_batch, 
+        points, offsets, bounds, Nx, Ny, sort_z);
+}
+
+std::pair<torch::Tensor,torch::Tensor> 
+build_grid2d_batch_cpu(
+    torch::Tensor points,
+    torch::Tensor offsets,
+    torch::Tensor bounds,
+    int Nx,
+    int Ny,
+    bool sort_z)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(offsets);
+    CHECK_CPU(bounds);
+    const int N = points.size(0);
+    const int B = offsets.size(0) - 1;
+    const int K = Nx * Ny;
+
+    const int* offsets_ptr = offsets.data_ptr<int>();
+    const auto bounds_acc = bounds.accessor<float,2>();
+    TORCH_CHECK(offsets_ptr[0] == 0 and offsets_ptr[B] == N, "offsets must start at 0 and end at N");
+    for(int b = 0; b < B; ++b)
+    {
+        TORCH_CHECK(offsets_ptr[b] <= offsets_ptr[b+1], "offsets must be sorted");
+        TORCH_CHECK(bounds_acc[b][0] < bounds_acc[b][1], "xmin must be lower than xmax");
+        TORCH_CHECK(bounds_acc[b][2] < bounds_acc[b][3], "ymin must be lower than ymax");
+    }
+
+    auto indices = torch::empty({N}, torch::kInt32);
+    auto cells = torch::empty({B,Nx,Ny,2}, torch::kInt32);
+
+    const auto points_acc = points.accessor<float,2>();
+    auto cells_acc = cells.accessor<int,4>();
+    int* indices_ptr = indices.data_ptr<int>();
+
+    // 1. one key per point, (sample,row,column) in the order of build_grid2d,
+    //    points out of bounds get the last key B*K
+    std::vector<int> keys(N);
+    at::parallel_for(0, N, 4096, [&](int64_t begin, int64_t end)
+    {
+        int b = std::upper_bound(offsets_ptr, offsets_ptr + B + 1, begin) - offsets_ptr - 1;
+        for(int64_t i = begin; i < end; ++i)
+        {
+            while(offsets_ptr[b+1] <= i) ++b;
+            const float xmin = bounds_acc[b][0];
+            const float xmax = bounds_acc[b][1];
+            const float ymin = bounds_acc[b][2];
+            const float ymax = bounds_acc[b][3];
+            const float x = points_acc[i][0];
+            const float y = points_acc[i][1];
+            if(xmin <= x and x < xmax and ymin <= y and y < ymax) {
+                const int ix = internal::cell_coord(x, xmin, (xmax - xmin) / Nx, Nx);
+                const int iy = internal::cell_coord(y, ymin, (ymax - ymin) / Ny, Ny);
+                keys[i] = b * K + iy * Nx + ix;
+            } else {
+                keys[i] = B * K;
+            }
+        }
+    });
+
+    // 2. parallel counting sort over all points of all samples
+    std::vector<int> key_offsets(B * K + 2);
+    counting_sort(keys.data(), N, B * K + 1, key_offsets.data(), indices_ptr);
+
+    // 3. cells and z sort, balanced over all cells of all samples
+    const auto OrderZ = [&points_acc](int i, int j) -> bool {
+        return points_acc[i][2] < points_acc[j][2];
+    };
+    parallel_for(B * K, [&](int k)
+    {
+        const int b  = k / K;
+        const int iy = (k % K) / Nx;
+        const int ix = (k % K) % Nx;
+        const int begin = key_offsets[k];
+        const int end   = key_offsets[k+1];
+        cells_acc[b][ix][iy][0] = begin;
+        cells_acc[b][ix][iy][1] = end;
+        if(sort_z)
+            std::sort(indices_ptr + begin, indices_ptr + end, OrderZ);
+    }, 64);
+
+    return std::make_pair(cells, indices);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> 
+build_grid2d_auto(
+    torch::Tensor points,
+    float cell_size,
+    float points_per_cell,
+    bool sort_z)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < points.size(0), "points must not be empty");
+    TORCH_CHECK((0 < cell_size) != (0 < points_per_cell), 
+        "exactly one of cell_size and points_per_cell must be positive");
+    DISPATCH(points.device(), build_grid2d_auto, 
+        points, cell_size, points_per_cell, sort_z);
+}
+
+std::tuple<torch::Tensor,torch::Tensor,torch::Tensor> 
+build_grid2d_auto_cpu(
+    torch::Tensor points,
+    float cell_size,
+    float points_per_cell,
+    bool sort_z)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+
+    // 1. bounds of the points in one parallel pass
+    const internal::Box box = internal::bounding_box(points.data_ptr<float>(), N);
+    const float ex = box.max[0] - box.min[0];
+    const float ey = box.max[1] - box.min[1];
+
+    // 2. cell size
+    float d = cell_size;
+    if(d <= 0)
+    {
+        if(0 < ex and 0 < ey)
+            d = std::sqrt(ex * ey * points_per_cell / N);
+        else
+            d = std::max(ex, ey) * points_per_cell / N;
+        if(not (0 < d))
+            d = 1;
+    }
+
+    // 3. number of cells so that max < min + n*d, whatever the rounding, the
+    //    counts are checked in double before any integer conversion
+    const int64_t max_cells = std::numeric_limits<int>::max();
+    const auto count = [d,max_cells](float vmin, float vmax) -> int64_t {
+        const double ratio = (double(vmax) - vmin) / d;
+        TORCH_CHECK(ratio < max_cells, "too many cells, increase the cell size");
+        int64_t n = std::max<int64_t>(1, static_cast<int64_t>(std::floor(ratio)) + 1);
+        while(not (vmax < vmin + n * d)) {
+            ++n;
+            TORCH_CHECK(n <= max_cells, "too many cells, increase the cell size");
+        }
+        return n;
+    };
+    const int64_t Nx = count(box.min[0], box.max[0]);
+    const int64_t Ny = count(box.min[1], box.max[1]);
+    TORCH_CHECK(double(Nx) * double(Ny) <= max_cells, "too many cells, increase the cell size");
+
+    const float xmin = box.min[0];
+    const float xmax = box.min[0] + Nx * d;
+    const float ymin = box.min[1];
+    const float ymax = box.min[1] + Ny * d;
+    auto bounds = torch::empty({4}, torch::kFloat32);
+    float* bounds_ptr = bounds.data_ptr<float>();
+    bounds_ptr[0] = xmin;
+    bounds_ptr[1] = xmax;
+    bounds_ptr[2] = ymin;
+    bounds_ptr[3] = ymax;
+
+    torch::Tensor cells, indices;
+    std::tie(cells, indices) = build_grid2d_cpu(points, xmin, xmax, ymin, ymax, Nx, Ny, sort_z);
+    return std::make_tuple(cells, indices, bounds);
+}
+
+} // namespace torch_points
\ No newline at end of file
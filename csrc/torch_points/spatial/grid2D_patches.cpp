@@ -0,0 +1,157 @@
+#include <torch_points/spatial/grid2D_patches.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/random.h>
+
+namespace torch_points {
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor,torch::Tensor,torch::Tensor> grid2d_to_patches(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    int K,
+    int min_points,
+    torch::optional<torch::Tensor> bounds,
+    int64_t seed)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    CHECK_CONTIGUOUS(cells);
+    CHECK_CONTIGUOUS(indices);
+    if(features.has_value()) {
+        CHECK_CONTIGUOUS(features.value());
+        TORCH_CHECK(1 <= features->dim() and features->size(0) == points.size(0), 
+            "features must have size [N,...]");
+    }
+    TORCH_CHECK(cells.dim() == 3 and cells.size(2) == 2, "cells must have size [Nx,Ny,2]");
+    TORCH_CHECK(indices.dim() == 1, "indices must have size [N]");
+    TORCH_CHECK(not bounds.has_value() or bounds->numel() == 4, "bounds must have 4 values");
+    TORCH_CHECK(0 < K, "K must be positive");
+    DISPATCH(points.device(), grid2d_to_patches, 
+        points, features, cells, indices, K, min_points, bounds, seed);
+}
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor,torch::Tensor,torch::Tensor> grid2d_to_patches_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    int K,
+    int min_points,
+    torch::optional<torch::Tensor> bounds,
+    int64_t seed)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(cells);
+    CHECK_CPU(indices);
+    const int N = points.size(0);
+    const int Nx = cells.size(0);
+    const int Ny = cells.size(1);
+    const float* points_ptr = points.data_ptr<float>();
+    const int* cells_ptr = cells.data_ptr<int>();
+    const int* indices_ptr = indices.data_ptr<int>();
+    const int size = indices.size(0);
+
+    float center[4] = {0, 0, 0, 0}; // x0, dx, y0, dy
+    if(bounds.has_value())
+    {
+        CHECK_CPU(bounds.value());
+        const auto bounds_float = bounds->to(torch::kFloat32).contiguous();
+        const float* b = bounds_float.data_ptr<float>();
+        center[1] = (b[1] - b[0]) / Nx;
+        center[3] = (b[3] - b[2]) / Ny;
+        center[0] = b[0] + 0.5f * center[1];
+        center[2] = b[2] + 0.5f * center[3];
+    }
+
+    // 1. patch of each cell
+    const int C = Nx * Ny;
+    const int threshold = std::max(min_points, 1);
+    std::vector<int> patch(C + 1, 0);
+    for(int c = 0; c < C; ++c)
+    {
+        const int begin = cells_ptr[2*c+0];
+        const int end = cells_ptr[2*c+1];
+        TORCH_CHECK(0 <= begin and begin <= end and end <= size, "invalid cell range");
+        patch[c+1] = patch[c] + (threshold <= end - begin);
+    }
+    const int P = patch[C];
+
+    auto out_points = torch::empty({P,K,3}, torch::kFloat32);
+    auto out_indices = torch::empty({P,K}, torch::kInt32);
+    auto out_cells = torch::empty({P,2}, torch::kInt32);
+    auto mask = torch::empty({P,K}, torch::kBool);
+    torch::optional<torch::Tensor> out_features;
+    const char* features_ptr = nullptr;
+    char* out_features_ptr = nullptr;
+    int64_t row = 0;
+    if(features.has_value())
+    {
+        CHECK_CPU(features.value());
+        const auto features_sizes = features->sizes();
+        std::vector<int64_t> sizes = {P, K};
+        sizes.insert(sizes.end(), features_sizes.begin() + 1, features_sizes.end());
+        out_features = torch::empty(sizes, features->options());
+        row = N == 0 ? 0 : features->numel() / N * features->element_size();
+        features_ptr = static_cast<const char*>(features->data_ptr());
+        out_features_ptr = static_cast<char*>(out_features->data_ptr());
+    }
+    float* out_points_ptr = out_points.data_ptr<float>();
+    int* out_indices_ptr = out_indices.data_ptr<int>();
+    int* out_cells_ptr = out_cells.data_ptr<int>();
+    bool* mask_ptr = mask.data_ptr<bool>();
+
+    // 2. patches
+    at::parallel_for(0, C, 64, [&](int64_t c_begin, int64_t c_end)
+    {
+        for(int64_t c = c_begin; c < c_end; ++c)
+        {
+            if(patch[c] == patch[c+1])
+                continue;
+            const int p = patch[c];
+            const int i = c / Ny;
+            const int j = c % Ny;
+            const int begin = cells_ptr[2*c+0];
+            const int n = cells_ptr[2*c+1] - begin;
+            int* idx = out_indices_ptr + int64_t(p) * K;
+            if(K < n)
+            {
+                std::mt19937_64 rng = make_generator(seed, c);
+                sample_indices(n, K, rng, idx);
+                for(int k = 0; k < K; ++k)
+                    idx[k] = indices_ptr[begin + idx[k]];
+            }
+            else
+            {
+                for(int k = 0; k < K; ++k)
+                    idx[k] = indices_ptr[begin + k % n];
+            }
+            // indices of the cells are increasing unless sort_z was used
+            std::sort(idx, idx + std::min(n, K));
+            for(int k = n; k < K; ++k)
+                idx[k] = idx[k % n];
+
+            out_cells_ptr[2*p+0] = i;
+            out_cells_ptr[2*p+1] = j;
+            const float cx = bounds.has_value() ? center[0] + i * center[1] : 0;
+            const float cy = bounds.has_value() ? center[2] + j * center[3] : 0;
+            for(int k = 0; k < K; ++k)
+            {
+                TORCH_CHECK(0 <= idx[k] and idx[k] < N, "invalid point index");
+                const float* q = points_ptr + 3 * int64_t(idx[k]);
+                float* out = out_points_ptr + (int64_t(p) * K + k) * 3;
+                out[0] = q[0] - cx;
+                out[1] = q[1] - cy;
+                out[2] = q[2];
+                mask_ptr[int64_t(p) * K + k] = k < n;
+                if(features_ptr != nullptr)
+                    std::memcpy(out_features_ptr + (int64_t(p) * K + k) * row, 
+                        features_ptr + int64_t(idx[k]) * row, row);
+            }
+        }
+    });
+    return std::make_tuple(out_points, out_features, out_indices, out_cells, mask);
+}
+
+} // namespace torch_points
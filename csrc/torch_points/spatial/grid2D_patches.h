@@ -0,0 +1,50 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// fixed-size patches of the cells returned by build_grid2d
+//
+// features:   optional (N,...) of any dtype, gathered with the points
+// K:          number of points of each patch
+// min_points: cells with less points do not give a patch
+// bounds:     optional float (4) xmin/xmax/ymin/ymax of the grid, the x/y coordinates
+//             of the patches are then relative to the center of their cell
+// seed:       cells with more than K points are subsampled without replacement,
+//             the points of a cell only depend on the seed and the cell
+//
+// returns, P being the number of cells with at least max(min_points,1) points,
+// in the order of the cells
+//      points:   float (P,K,3)
+//      features: (P,K,...)
+//      indices:  int (P,K):  indices in points of the points of each patch, in
+//                            increasing order, repeated cyclically in the cells
+//                            with less than K points
+//      cells:    int (P,2):  cell (i,j) of each patch
+//      mask:     bool (P,K): false for the repeated points
+//
+// patches are written in one parallel pass over the cells
+//
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor,torch::Tensor,torch::Tensor> grid2d_to_patches(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    int K,
+    int min_points,
+    torch::optional<torch::Tensor> bounds,
+    int64_t seed);
+
+std::tuple<torch::Tensor,torch::optional<torch::Tensor>,torch::Tensor,torch::Tensor,torch::Tensor> grid2d_to_patches_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> features,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    int K,
+    int min_points,
+    torch::optional<torch::Tensor> bounds,
+    int64_t seed);
+
+} // namespace torch_points
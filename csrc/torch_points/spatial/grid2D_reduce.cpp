@@ -0,0 +1,302 @@
+#include <torch_points/spatial/grid2D_reduce.h>
+#include <torch_points/spatial/internal/cell.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+#include <torch_points/common/counting_sort.h>
+
+namespace torch_points {
+
+namespace {
+
+enum class Op { Count, Min, Max, Mean, Std, ArgMin, ArgMax };
+
+Op parse_op(const std::string& op)
+{
+    if(op == "count")  return Op::Count;
+    if(op == "min")    return Op::Min;
+    if(op == "max")    return Op::Max;
+    if(op == "mean")   return Op::Mean;
+    if(op == "std")    return Op::Std;
+    if(op == "argmin") return Op::ArgMin;
+    if(op == "argmax") return Op::ArgMax;
+    TORCH_CHECK(false, "unknown grid2d reduction '", op, "'");
+}
+
+void check_values(torch::Tensor points, torch::optional<torch::Tensor> values)
+{
+    if(not values.has_value())
+        return;
+    CHECK_CONTIGUOUS(*values);
+    TORCH_CHECK(values->dim() == 1 and values->size(0) == points.size(0), 
+        "values must have size [N]");
+    TORCH_CHECK(values->scalar_type() == torch::kFloat32, "values must be float");
+}
+
+//
+// running statistics, the variance is updated with Welford's algorithm and
+// merged with Chan's formula, ties of argmin/argmax go to the lowest index,
+// an unset index (-1) is always replaced so that infinite values get one
+//
+struct Stats
+{
+    int count = 0;
+    float min = +INFINITY;
+    float max = -INFINITY;
+    double mean = 0;
+    double m2 = 0;
+    int argmin = -1;
+    int argmax = -1;
+
+    void push(float v, int i)
+    {
+        ++count;
+        const double delta = v - mean;
+        mean += delta / count;
+        m2 += delta * (v - mean);
+        if(v < min or (v == min and (argmin < 0 or i < argmin))) {
+            min = v;
+            argmin = i;
+        }
+        if(max < v or (v == max and (argmax < 0 or i < argmax))) {
+            max = v;
+            argmax = i;
+        }
+    }
+
+    void merge(const Stats& other)
+    {
+        if(other.count == 0)
+            return;
+        const int n = count + other.count;
+        const double delta = other.mean - mean;
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * count * other.count / n;
+        count = n;
+        if(other.min < min or (other.min == min and (argmin < 0 or other.argmin < argmin))) {
+            min = other.min;
+            argmin = other.argmin;
+        }
+        if(max < other.max or (other.max == max and (argmax < 0 or other.argmax < argmax))) {
+            max = other.max;
+            argmax = other.argmax;
+        }
+    }
+};
+
+// one (Nx,Ny) image per op
+class Images
+{
+public:
+    Images(const std::vector<std::string>& ops, int Nx, int Ny)
+    {
+        for(const auto& op : ops)
+        {
+            m_ops.push_back(parse_op(op));
+            const bool is_int = m_ops.back() == Op::Count or m_ops.back() == Op::ArgMin or m_ops.back() == Op::ArgMax;
+            m_tensors.push_back(torch::empty({Nx,Ny}, is_int ? torch::kInt32 : torch::kFloat32));
+            m_data.push_back(m_tensors.back().data_ptr());
+        }
+    }
+
+    // c is the flat index ix*Ny+iy
+    void write(int c, const Stats& s)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const bool empty = s.count == 0;
+        for(size_t k = 0; k < m_ops.size(); ++k)
+        {
+            int* i = static_cast<int*>(m_data[k]) + c;
+            float* f = static_cast<float*>(m_data[k]) + c;
+            switch(m_ops[k]) {
+            case Op::Count:  *i = s.count; break;
+            case Op::Min:    *f = empty ? nan : s.min; break;
+            case Op::Max:    *f = empty ? nan : s.max; break;
+            case Op::Mean:   *f = empty ? nan : s.mean; break;
+            case Op::Std:    *f = empty ? nan : std::sqrt(s.m2 / s.count); break;
+            case Op::ArgMin: *i = s.argmin; break;
+            case Op::ArgMax: *i = s.argmax; break;
+            }
+        }
+    }
+
+    std::vector<torch::Tensor> tensors() const
+    {
+        return m_tensors;
+    }
+
+protected:
+    std::vector<Op> m_ops;
+    std::vector<torch::Tensor> m_tensors;
+    std::vector<void*> m_data;
+};
+
+} // anonymous namespace
+
+std::vector<torch::Tensor> grid2d_reduce(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    const std::vector<std::string>& ops)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    CHECK_CONTIGUOUS(cells);
+    CHECK_CONTIGUOUS(indices);
+    check_values(points, values);
+    TORCH_CHECK(cells.dim() == 3 and cells.size(2) == 2, "cells must have size [Nx,Ny,2]");
+    TORCH_CHECK(indices.dim() == 1, "indices must have size [N]");
+    for(const auto& op : ops)
+        parse_op(op);
+    DISPATCH(points.device(), grid2d_reduce, 
+        points, values, cells, indices, ops);
+}
+
+std::vector<torch::Tensor> grid2d_reduce_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    const std::vector<std::string>& ops)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(cells);
+    CHECK_CPU(indices);
+    const int N = points.size(0);
+    const int Nx = cells.size(0);
+    const int Ny = cells.size(1);
+    const float* points_ptr = points.data_ptr<float>();
+    const float* values_ptr = values.has_value() ? values->data_ptr<float>() : nullptr;
+    const int* cells_ptr = cells.data_ptr<int>();
+    const int* indices_ptr = indices.data_ptr<int>();
+    const int size = indices.size(0);
+
+    Images images(ops, Nx, Ny);
+    parallel_for(Nx * Ny, [&](int c)
+    {
+        const int begin = cells_ptr[2*c+0];
+        const int end   = cells_ptr[2*c+1];
+        TORCH_CHECK(0 <= begin and begin <= end and end <= size, "invalid cell range");
+        Stats s;
+        for(int k = begin; k < end; ++k)
+        {
+            const int i = indices_ptr[k];
+            TORCH_CHECK(0 <= i and i < N, "invalid point index");
+            s.push(values_ptr ? values_ptr[i] : points_ptr[3*i+2], i);
+        }
+        images.write(c, s);
+    }, 256);
+    return images.tensors();
+}
+
+std::vector<torch::Tensor> grid2d_rasterize(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    float xmin,
+    float xmax,
+    float ymin,
+    float ymax,
+    int Nx,
+    int Ny,
+    const std::vector<std::string>& ops)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    check_values(points, values);
+    TORCH_CHECK(0 < Nx);
+    TORCH_CHECK(0 < Ny);
+    TORCH_CHECK(xmin < xmax);
+    TORCH_CHECK(ymin < ymax);
+    for(const auto& op : ops)
+        parse_op(op);
+    DISPATCH(points.device(), grid2d_rasterize, 
+        points, values, xmin, xmax, ymin, ymax, Nx, Ny, ops);
+}
+
+std::vector<torch::Tensor> grid2d_rasterize_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    float xmin,
+    float xmax,
+    float ymin,
+    float ymax,
+    int Nx,
+    int Ny,
+    const std::vector<std::string>& ops)
+{
+    CHECK_CPU(points);
+    const int N = points.size(0);
+    const int K = Nx * Ny;
+    const float* points_ptr = points.data_ptr<float>();
+    const float* values_ptr = values.has_value() ? values->data_ptr<float>() : nullptr;
+    const float dx = (xmax - xmin) / Nx;
+    const float dy = (ymax - ymin) / Ny;
+
+    const auto cell_of = [&](int64_t i) {
+        const float x = points_ptr[3*i+0];
+        const float y = points_ptr[3*i+1];
+        if(not (xmin <= x and x < xmax and ymin <= y and y < ymax))
+            return K;
+        const int ix = internal::cell_coord(x, xmin, dx, Nx);
+        const int iy = internal::cell_coord(y, ymin, dy, Ny);
+        return ix * Ny + iy;
+    };
+    const auto value_of = [&](int64_t i) {
+        return values_ptr ? values_ptr[i] : points_ptr[3*i+2];
+    };
+    Images images(ops, Nx, Ny);
+
+    // dense grids: each chunk of points is reduced into its own image, the
+    // number of chunks is limited so that the images hold at most N stats
+    const int64_t T = std::min<int64_t>(at::get_num_threads(), N / K);
+    if(T >= 2)
+    {
+        const int64_t chunk = (N + T - 1) / T;
+        std::vector<Stats> stats(T * K);
+        at::parallel_for(0, T, 1, [&](int64_t t_begin, int64_t t_end)
+        {
+            for(int64_t t = t_begin; t < t_end; ++t)
+            {
+                Stats* image = stats.data() + t * K;
+                const int64_t end = std::min<int64_t>(N, (t+1) * chunk);
+                for(int64_t i = t * chunk; i < end; ++i) {
+                    const int c = cell_of(i);
+                    if(c < K)
+                        image[c].push(value_of(i), i);
+                }
+            }
+        });
+        parallel_for(K, [&](int c)
+        {
+            Stats s = stats[c];
+            for(int64_t t = 1; t < T; ++t)
+                s.merge(stats[t * K + c]);
+            images.write(c, s);
+        }, 1024);
+        return images.tensors();
+    }
+
+    // sparse grids: the points are binned by cell with a counting sort, points
+    // outside of the grid go to the cell K, then each cell is reduced in one
+    // pass as in grid2d_reduce
+    std::vector<int> keys(N);
+    at::parallel_for(0, N, 16384, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+            keys[i] = cell_of(i);
+    });
+    std::vector<int> offsets(K + 2);
+    std::vector<int> order(N);
+    counting_sort(keys.data(), N, K + 1, offsets.data(), order.data());
+    parallel_for(K, [&](int c)
+    {
+        Stats s;
+        for(int k = offsets[c]; k < offsets[c+1]; ++k)
+            s.push(value_of(order[k]), order[k]);
+        images.write(c, s);
+    }, 1024);
+    return images.tensors();
+}
+
+} // namespace torch_points
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// per cell statistics of values over a 2D grid, computed in one parallel pass
+//
+// values: optional float (N), z coordinates of the points by default
+// ops:    reductions among
+//          "count":  int,   number of points
+//          "min":    float, minimum value, nan if empty
+//          "max":    float, maximum value, nan if empty
+//          "mean":   float, mean value, nan if empty
+//          "std":    float, standard deviation, nan if empty
+//          "argmin": int,   index in points of the minimum, -1 if empty
+//          "argmax": int,   index in points of the maximum, -1 if empty
+//
+// returns one (Nx,Ny) image per op
+//
+
+// reduction over the cells returned by build_grid2d, each cell is a contiguous
+// range of indices so cells are reduced independently in parallel
+std::vector<torch::Tensor> grid2d_reduce(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    const std::vector<std::string>& ops);
+
+std::vector<torch::Tensor> grid2d_reduce_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    torch::Tensor cells,
+    torch::Tensor indices,
+    const std::vector<std::string>& ops);
+
+// same reduction with the cells of build_grid2d computed on the fly: on
+// dense grids each thread reduces a chunk of points into its own image and
+// the images are merged, with at most N cell statistics in total; on sparse
+// grids the points are binned by cell with a counting sort and each cell is
+// reduced in one pass, so the scratch memory is O(N+K) ints for K = Nx*Ny
+std::vector<torch::Tensor> grid2d_rasterize(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    float xmin,
+    float xmax,
+    float ymin,
+    float ymax,
+    int Nx,
+    int Ny,
+    const std::vector<std::string>& ops);
+
+std::vector<torch::Tensor> grid2d_rasterize_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> values,
+    float xmin,
+    float xmax,
+    float ymin,
+    float ymax,
+    int Nx,
+    int Ny,
+    const std::vector<std::string>& ops);
+
+} // namespace torch_points
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <torch/extension.h>
+
+#include <limits>
+
+namespace torch_points {
+namespace internal {
+
+struct Box
+{
+    float min[3];
+    float max[3];
+
+    static Box empty()
+    {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        return {{+inf, +inf, +inf}, {-inf, -inf, -inf}};
+    }
+
+    void extend(const Box& other)
+    {
+        for(int k = 0; k < 3; ++k) {
+            min[k] = std::min(min[k], other.min[k]);
+            max[k] = std::max(max[k], other.max[k]);
+        }
+    }
+};
+
+//
+// bounding box of N contiguous 3D points
+// each thread reduces a chunk into local accumulators (branch-free min/max)
+//
+inline Box bounding_box(const float* points, int N)
+{
+    return at::parallel_reduce(0, N, 16384, Box::empty(),
+        [points](int64_t begin, int64_t end, Box box) -> Box
+        {
+            float x0 = box.min[0], y0 = box.min[1], z0 = box.min[2];
+            float x1 = box.max[0], y1 = box.max[1], z1 = box.max[2];
+            for(int64_t i = begin; i < end; ++i)
+            {
+                const float x = points[3*i+0];
+                const float y = points[3*i+1];
+                const float z = points[3*i+2];
+                x0 = x < x0 ? x : x0;  x1 = x1 < x ? x : x1;
+                y0 = y < y0 ? y : y0;  y1 = y1 < y ? y : y1;
+                z0 = z < z0 ? z : z0;  z1 = z1 < z ? z : z1;
+            }
+            return {{x0, y0, z0}, {x1, y1, z1}};
+        },
+        [](Box a, const Box& b) -> Box
+        {
+            a.extend(b);
+            return a;
+        });
+}
+
+} // namespace internal
+} // namespace torch_points
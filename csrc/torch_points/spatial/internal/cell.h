@@ -0,0 +1,24 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace torch_points {
+namespace internal {
+
+//
+// index of the cell containing x, with the same float arithmetic as 
+// build_grid2d: cell i covers [vmin + i*d, vmin + (i+1)*d)
+// x must lie in [vmin, vmax)
+//
+inline int cell_coord(float x, float vmin, float d, int n)
+{
+    int i = static_cast<int>(std::floor((x - vmin) / d));
+    i = std::min(std::max(i, 0), n-1);
+    while(0 < i and x < vmin + i * d) --i;
+    while(i < n-1 and vmin + (i+1) * d <= x) ++i;
+    return i;
+}
+
+} // namespace internal
+} // namespace torch_points
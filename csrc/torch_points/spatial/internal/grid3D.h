@@ -0,0 +1,285 @@
+#pragma once
+
+#include <torch_points/common/counting_sort.h>
+#include <torch_points/spatial/internal/box.h>
+#include <torch_points/spatial/internal/knn_heap.h>
+
+namespace torch_points {
+namespace internal {
+
+//
+// uniform 3D grid over points[begin:end], used as a neighbor search index
+//
+// cells are stored in CSR format by a counting sort (same machinery as
+// build_grid2d_batch), points are copied in cell order with one array per
+// coordinate so that the distances in a cell are computed by a vectorized loop
+// the indices passed to callbacks and heaps are the global indices in [begin,end)
+//
+class Grid3D
+{
+public:
+    Grid3D() = default;
+
+    //
+    // the cell size is at least the one giving points_per_cell points per cell,
+    // which also bounds the number of cells
+    //
+    void build(
+        const float* points,
+        int begin,
+        int end,
+        float cell_size,
+        float points_per_cell = 0.25f)
+    {
+        const int n = end - begin;
+        m_box = n == 0 ? Box{{0,0,0},{0,0,0}} : bounding_box(points + 3 * int64_t(begin), n);
+        m_cell = std::max(cell_size, cell_size_for(m_box, n, std::max(points_per_cell, 0.25f)));
+        int64_t total = 1;
+        for(int d = 0; d < 3; ++d) {
+            m_n[d] = 1 + static_cast<int>(std::floor((m_box.max[d] - m_box.min[d]) / m_cell));
+            total *= m_n[d];
+        }
+        TORCH_CHECK(total < std::numeric_limits<int>::max(), "too many grid cells");
+        const int K = total;
+
+        std::vector<int> keys(n);
+        at::parallel_for(0, n, 4096, [&](int64_t i_begin, int64_t i_end)
+        {
+            for(int64_t i = i_begin; i < i_end; ++i)
+                keys[i] = cell_index(points + 3 * (begin + i));
+        });
+        m_offsets.resize(K + 1);
+        m_indices.resize(n);
+        counting_sort(keys.data(), n, K, m_offsets.data(), m_indices.data());
+
+        m_x.resize(n);
+        m_y.resize(n);
+        m_z.resize(n);
+        at::parallel_for(0, n, 4096, [&](int64_t i_begin, int64_t i_end)
+        {
+            for(int64_t i = i_begin; i < i_end; ++i)
+            {
+                m_indices[i] += begin;
+                const float* p = points + 3 * int64_t(m_indices[i]);
+                m_x[i] = p[0];
+                m_y[i] = p[1];
+                m_z[i] = p[2];
+            }
+        });
+    }
+
+    //
+    // cell size of a grid with about points_per_cell points per non-empty cell,
+    // axes thinner than a cell (planar or linear clouds) are not subdivided
+    //
+    static float cell_size_for(const Box& box, int n, float points_per_cell)
+    {
+        float e[3];
+        for(int d = 0; d < 3; ++d)
+            e[d] = box.max[d] - box.min[d];
+        std::sort(e, e + 3);
+        const float cells = std::max(1.f, n / points_per_cell);
+        for(int dims = 3; 1 <= dims; --dims)
+        {
+            float volume = 1;
+            for(int d = 3 - dims; d < 3; ++d)
+                volume *= e[d];
+            const float cell = std::pow(volume / cells, 1.f / dims);
+            if(0 < cell and e[3 - dims] >= cell)
+                return cell;
+        }
+        return 0 < e[2] ? e[2] : 1;
+    }
+
+    bool empty() const
+    {
+        return m_indices.empty();
+    }
+
+    int coord(float x, int d) const
+    {
+        const int i = static_cast<int>(std::floor((x - m_box.min[d]) / m_cell));
+        return std::min(std::max(i, 0), m_n[d] - 1);
+    }
+
+    int cell_index(const float* p) const
+    {
+        return (coord(p[2], 2) * m_n[1] + coord(p[1], 1)) * m_n[0] + coord(p[0], 0);
+    }
+
+    //
+    // f(index, d2) is called for each point at distance at most r from q
+    //
+    template<typename F>
+    void for_each_in_radius(const float* q, float r, F&& f) const
+    {
+        if(empty())
+            return;
+        const float r2 = r * r;
+        int lo[3], hi[3];
+        for(int d = 0; d < 3; ++d) {
+            lo[d] = coord(q[d] - r, d);
+            hi[d] = coord(q[d] + r, d);
+        }
+        for(int iz = lo[2]; iz <= hi[2]; ++iz)
+        for(int iy = lo[1]; iy <= hi[1]; ++iy)
+        for(int ix = lo[0]; ix <= hi[0]; ++ix)
+        {
+            scan_cell((iz * m_n[1] + iy) * m_n[0] + ix, q, [&](int i, float d2) {
+                if(d2 <= r2)
+                    f(i, d2);
+            });
+        }
+    }
+
+    //
+    // number of points at distance at most r from q, the cells are visited in
+    // shells around the cell of q and the search stops as soon as max_count
+    // points are found
+    //
+    int count_in_radius(const float* q, float r, int max_count) const
+    {
+        if(empty() or max_count <= 0)
+            return 0;
+        const float r2 = r * r;
+        int c[3], lo[3], hi[3];
+        int shells = 0;
+        for(int d = 0; d < 3; ++d) {
+            c[d] = coord(q[d], d);
+            lo[d] = coord(q[d] - r, d);
+            hi[d] = coord(q[d] + r, d);
+            shells = std::max({shells, c[d] - lo[d], hi[d] - c[d]});
+        }
+        int count = 0;
+        for(int s = 0; s <= shells; ++s)
+        {
+            for(int iz = std::max(lo[2], c[2] - s); iz <= std::min(hi[2], c[2] + s); ++iz)
+            for(int iy = std::max(lo[1], c[1] - s); iy <= std::min(hi[1], c[1] + s); ++iy)
+            for(int ix = std::max(lo[0], c[0] - s); ix <= std::min(hi[0], c[0] + s); ++ix)
+            {
+                const bool shell =
+                    std::abs(ix - c[0]) == s or
+                    std::abs(iy - c[1]) == s or
+                    std::abs(iz - c[2]) == s;
+                if(not shell)
+                    continue;
+                scan_cell((iz * m_n[1] + iy) * m_n[0] + ix, q, [&](int, float d2) {
+                    count += d2 <= r2;
+                });
+                if(max_count <= count)
+                    return max_count;
+            }
+        }
+        return count;
+    }
+
+    //
+    // nearest neighbors search in shells of cells around q, until the
+    // unvisited cells are farther than the current k-th neighbor
+    //
+    void search(const float* q, KnnHeap& heap) const
+    {
+        if(empty())
+            return;
+        int c[3];
+        for(int d = 0; d < 3; ++d)
+            c[d] = coord(q[d], d);
+        for(int s = 0; ; ++s)
+        {
+            int lo[3], hi[3];
+            for(int d = 0; d < 3; ++d) {
+                lo[d] = std::max(c[d] - s, 0);
+                hi[d] = std::min(c[d] + s, m_n[d] - 1);
+            }
+            for(int iz = lo[2]; iz <= hi[2]; ++iz)
+            for(int iy = lo[1]; iy <= hi[1]; ++iy)
+            for(int ix = lo[0]; ix <= hi[0]; ++ix)
+            {
+                const bool shell =
+                    std::abs(ix - c[0]) == s or
+                    std::abs(iy - c[1]) == s or
+                    std::abs(iz - c[2]) == s;
+                if(not shell)
+                    continue;
+                scan_cell((iz * m_n[1] + iy) * m_n[0] + ix, q, [&](int i, float d2) {
+                    heap.push(i, d2);
+                });
+            }
+            // distance from q to the cells not visited yet
+            float bound = INFINITY;
+            for(int d = 0; d < 3; ++d) {
+                if(0 < c[d] - s)
+                    bound = std::min(bound, q[d] - (m_box.min[d] + (c[d] - s) * m_cell));
+                if(c[d] + s < m_n[d] - 1)
+                    bound = std::min(bound, m_box.min[d] + (c[d] + s + 1) * m_cell - q[d]);
+            }
+            if(std::isinf(bound))
+                return; // the whole grid has been visited
+            bound = std::max(bound, 0.f);
+            if(heap.worst() < bound * bound)
+                return;
+        }
+    }
+
+    template<typename F>
+    void scan_cell(int cell, const float* q, F&& f) const
+    {
+        constexpr int block = 64;
+        float buffer[block];
+        const int begin = m_offsets[cell];
+        const int end = m_offsets[cell+1];
+        for(int b = begin; b < end; b += block)
+        {
+            const int size = std::min(block, end - b);
+            for(int j = 0; j < size; ++j) {
+                const float dx = m_x[b+j] - q[0];
+                const float dy = m_y[b+j] - q[1];
+                const float dz = m_z[b+j] - q[2];
+                buffer[j] = dx*dx + dy*dy + dz*dz;
+            }
+            for(int j = 0; j < size; ++j)
+                f(m_indices[b+j], buffer[j]);
+        }
+    }
+
+public:
+    Box m_box;
+    float m_cell;
+    int m_n[3];
+    std::vector<int> m_offsets;  // (cells+1)
+    std::vector<int> m_indices;  // global indices in cell order
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+};
+
+//
+// one grid per sample points[offsets[b]:offsets[b+1]]
+// samples are built in parallel when there are enough of them,
+// otherwise one after the other with a parallel counting sort each
+//
+inline std::vector<Grid3D> build_grids(
+    const float* points,
+    const std::vector<int>& offsets,
+    float cell_size,
+    float points_per_cell = 0.25f)
+{
+    const int B = offsets.size() - 1;
+    std::vector<Grid3D> grids(B);
+    const auto build = [&](int64_t b) {
+        grids[b].build(points, offsets[b], offsets[b+1], cell_size, points_per_cell);
+    };
+    if(at::get_num_threads() <= B) {
+        at::parallel_for(0, B, 1, [&](int64_t b_begin, int64_t b_end) {
+            for(int64_t b = b_begin; b < b_end; ++b)
+                build(b);
+        });
+    } else {
+        for(int b = 0; b < B; ++b)
+            build(b);
+    }
+    return grids;
+}
+
+} // namespace internal
+} // namespace torch_points
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <torch_points/spatial/internal/morton.h>
+
+#include <algorithm>
+
+namespace torch_points {
+namespace internal {
+
+//
+// Hilbert codes of integer coordinates with the given number of bits per axis
+//
+// coordinates are converted to the "transposed" Hilbert index with Skilling's
+// algorithm (Programming the Hilbert curve, 2004), whose bits are then
+// interleaved as a Morton code with the first axis most significant
+//
+template<int D>
+struct Hilbert
+{
+    static constexpr int max_bits = Morton<D>::max_bits;
+
+    static uint64_t encode(const uint32_t* q, int bits)
+    {
+        uint32_t x[D];
+        std::copy(q, q + D, x);
+        const uint32_t M = 1u << (bits - 1);
+        // inverse undo
+        for(uint32_t Q = M; 1 < Q; Q >>= 1)
+        {
+            const uint32_t P = Q - 1;
+            for(int i = 0; i < D; ++i)
+            {
+                if(x[i] & Q) {
+                    x[0] ^= P;
+                } else {
+                    const uint32_t t = (x[0] ^ x[i]) & P;
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+        // Gray encode
+        for(int i = 1; i < D; ++i)
+            x[i] ^= x[i-1];
+        uint32_t t = 0;
+        for(uint32_t Q = M; 1 < Q; Q >>= 1)
+            if(x[D-1] & Q)
+                t ^= Q - 1;
+        for(int i = 0; i < D; ++i)
+            x[i] ^= t;
+        std::reverse(x, x + D);
+        return Morton<D>::encode(x);
+    }
+};
+
+} // namespace internal
+} // namespace torch_points
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace torch_points {
+namespace internal {
+
+//
+// bounded max-heap of the k nearest candidates, stored in caller arrays
+// candidates farther than max_d2 are rejected
+//
+struct KnnHeap
+{
+    int* idx;
+    float* d2;
+    int k;
+    float max_d2;
+    int count;
+
+    KnnHeap(int* idx, float* d2, int k, float max_d2 = INFINITY) :
+        idx(idx), d2(d2), k(k), max_d2(max_d2), count(0) {}
+
+    // squared distance a candidate must not exceed to be kept
+    float worst() const
+    {
+        return count < k ? max_d2 : d2[0];
+    }
+
+    void push(int i, float d)
+    {
+        if(count < k) {
+            if(max_d2 < d)
+                return;
+            idx[count] = i;
+            d2[count] = d;
+            sift_up(count);
+            ++count;
+        } else if(d < d2[0]) {
+            idx[0] = i;
+            d2[0] = d;
+            sift_down(count, 0);
+        }
+    }
+
+    // sort by increasing distance, returns the number of candidates
+    int sort()
+    {
+        for(int size = count; 1 < size; --size)
+        {
+            std::swap(idx[0], idx[size-1]);
+            std::swap(d2[0], d2[size-1]);
+            sift_down(size-1, 0);
+        }
+        return count;
+    }
+
+    void sift_up(int i)
+    {
+        while(0 < i)
+        {
+            const int parent = (i - 1) / 2;
+            if(not (d2[parent] < d2[i]))
+                return;
+            std::swap(idx[i], idx[parent]);
+            std::swap(d2[i], d2[parent]);
+            i = parent;
+        }
+    }
+
+    void sift_down(int size, int i)
+    {
+        while(true)
+        {
+            const int l = 2*i + 1;
+            const int r = 2*i + 2;
+            int largest = i;
+            if(l < size and d2[largest] < d2[l]) largest = l;
+            if(r < size and d2[largest] < d2[r]) largest = r;
+            if(largest == i)
+                return;
+            std::swap(idx[i], idx[largest]);
+            std::swap(d2[i], d2[largest]);
+            i = largest;
+        }
+    }
+};
+
+} // namespace internal
+} // namespace torch_points
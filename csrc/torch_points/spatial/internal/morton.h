@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+namespace torch_points {
+namespace internal {
+
+//
+// Morton codes interleave the bits of integer coordinates (x in bit 0)
+//      2D: 32 bits per axis
+//      3D: 21 bits per axis
+//
+
+inline uint64_t expand_bits_2d(uint64_t v)
+{
+    v &= 0x00000000ffffffffull;
+    v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+    v = (v | (v <<  8)) & 0x00ff00ff00ff00ffull;
+    v = (v | (v <<  4)) & 0x0f0f0f0f0f0f0f0full;
+    v = (v | (v <<  2)) & 0x3333333333333333ull;
+    v = (v | (v <<  1)) & 0x5555555555555555ull;
+    return v;
+}
+
+inline uint64_t compact_bits_2d(uint64_t v)
+{
+    v &= 0x5555555555555555ull;
+    v = (v | (v >>  1)) & 0x3333333333333333ull;
+    v = (v | (v >>  2)) & 0x0f0f0f0f0f0f0f0full;
+    v = (v | (v >>  4)) & 0x00ff00ff00ff00ffull;
+    v = (v | (v >>  8)) & 0x0000ffff0000ffffull;
+    v = (v | (v >> 16)) & 0x00000000ffffffffull;
+    return v;
+}
+
+inline uint64_t expand_bits_3d(uint64_t v)
+{
+    v &= 0x00000000001fffffull;
+    v = (v | (v << 32)) & 0x001f00000000ffffull;
+    v = (v | (v << 16)) & 0x001f0000ff0000ffull;
+    v = (v | (v <<  8)) & 0x100f00f00f00f00full;
+    v = (v | (v <<  4)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v <<  2)) & 0x1249249249249249ull;
+    return v;
+}
+
+inline uint64_t compact_bits_3d(uint64_t v)
+{
+    v &= 0x1249249249249249ull;
+    v = (v | (v >>  2)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v >>  4)) & 0x100f00f00f00f00full;
+    v = (v | (v >>  8)) & 0x001f0000ff0000ffull;
+    v = (v | (v >> 16)) & 0x001f00000000ffffull;
+    v = (v | (v >> 32)) & 0x00000000001fffffull;
+    return v;
+}
+
+template<int D> struct Morton;
+
+template<> struct Morton<2>
+{
+    static constexpr int max_bits = 32;
+
+    static uint64_t encode(const uint32_t* q)
+    {
+        return expand_bits_2d(q[0]) | (expand_bits_2d(q[1]) << 1);
+    }
+
+    static void decode(uint64_t code, uint32_t* q)
+    {
+        q[0] = compact_bits_2d(code);
+        q[1] = compact_bits_2d(code >> 1);
+    }
+};
+
+template<> struct Morton<3>
+{
+    static constexpr int max_bits = 21;
+
+    static uint64_t encode(const uint32_t* q)
+    {
+        return expand_bits_3d(q[0]) | (expand_bits_3d(q[1]) << 1) | (expand_bits_3d(q[2]) << 2);
+    }
+
+    static void decode(uint64_t code, uint32_t* q)
+    {
+        q[0] = compact_bits_3d(code);
+        q[1] = compact_bits_3d(code >> 1);
+        q[2] = compact_bits_3d(code >> 2);
+    }
+};
+
+} // namespace internal
+} // namespace torch_points
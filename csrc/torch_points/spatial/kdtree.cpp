@@ -0,0 +1,213 @@
+#include <torch_points/spatial/kdtree.h>
+#include <torch_points/spatial/internal/knn_heap.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+
+namespace torch_points {
+
+KDTree::KDTree(torch::Tensor points, int leaf_size) :
+    m_leaf_size(leaf_size),
+    m_nodes(),
+    m_x(),
+    m_y(),
+    m_z(),
+    m_indices()
+{
+    CHECK_CPU(points);
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < leaf_size, "leaf_size must be positive");
+    const int N = points.size(0);
+    const float* points_ptr = points.data_ptr<float>();
+
+    m_indices.resize(N);
+    std::iota(m_indices.begin(), m_indices.end(), 0);
+
+    // 1. median splits level by level
+    m_nodes.push_back({0, N, -1, 0, 0});
+    std::vector<int> level = {0};
+    while(not level.empty())
+    {
+        const int L = level.size();
+        std::vector<int> counts(L + 1, 0);
+        parallel_for(L, [&](int k)
+        {
+            Node& node = m_nodes[level[k]];
+            if(node.end - node.begin <= m_leaf_size)
+                return;
+            float lo[3] = {+INFINITY, +INFINITY, +INFINITY};
+            float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+            for(int i = node.begin; i < node.end; ++i) {
+                const float* p = points_ptr + 3 * m_indices[i];
+                for(int d = 0; d < 3; ++d) {
+                    lo[d] = std::min(lo[d], p[d]);
+                    hi[d] = std::max(hi[d], p[d]);
+                }
+            }
+            int dim = 0;
+            for(int d = 1; d < 3; ++d)
+                if(hi[dim] - lo[dim] < hi[d] - lo[d])
+                    dim = d;
+            const int mid = node.begin + (node.end - node.begin) / 2;
+            std::nth_element(
+                m_indices.data() + node.begin,
+                m_indices.data() + mid,
+                m_indices.data() + node.end,
+                [&](int i, int j){return points_ptr[3*i+dim] < points_ptr[3*j+dim];});
+            node.dim = dim;
+            node.split = points_ptr[3 * m_indices[mid] + dim];
+            counts[k+1] = 2;
+        });
+        counts[0] = m_nodes.size();
+        for(int k = 0; k < L; ++k)
+            counts[k+1] += counts[k];
+        m_nodes.resize(counts[L]);
+        parallel_for(L, [&](int k)
+        {
+            Node& node = m_nodes[level[k]];
+            if(counts[k] == counts[k+1])
+                return;
+            const int mid = node.begin + (node.end - node.begin) / 2;
+            node.left = counts[k];
+            m_nodes[node.left+0] = {node.begin, mid, -1, 0, 0};
+            m_nodes[node.left+1] = {mid, node.end, -1, 0, 0};
+        });
+        std::vector<int> next_level(counts[L] - counts[0]);
+        std::iota(next_level.begin(), next_level.end(), counts[0]);
+        level.swap(next_level);
+    }
+
+    // 2. copy points in leaf order
+    m_x.resize(N);
+    m_y.resize(N);
+    m_z.resize(N);
+    parallel_for(N, [&](int i)
+    {
+        const float* p = points_ptr + 3 * m_indices[i];
+        m_x[i] = p[0];
+        m_y[i] = p[1];
+        m_z[i] = p[2];
+    }, 4096);
+}
+
+std::pair<torch::Tensor,torch::Tensor> KDTree::knn(torch::Tensor queries, int k) const
+{
+    CHECK_CPU(queries);
+    CHECK_POINTS(queries);
+    CHECK_CONTIGUOUS(queries);
+    TORCH_CHECK(0 < k, "k must be positive");
+    const int M = queries.size(0);
+    const float* queries_ptr = queries.data_ptr<float>();
+    auto indices = torch::empty({M,k}, torch::kInt32);
+    auto distances = torch::empty({M,k}, torch::kFloat32);
+    int* indices_ptr = indices.data_ptr<int>();
+    float* distances_ptr = distances.data_ptr<float>();
+    parallel_for(M, [&](int i)
+    {
+        int* idx = indices_ptr + int64_t(i) * k;
+        float* d = distances_ptr + int64_t(i) * k;
+        const int count = search_knn(queries_ptr + 3*i, k, idx, d);
+        for(int j = 0; j < count; ++j)
+            d[j] = std::sqrt(d[j]);
+        std::fill(idx + count, idx + k, -1);
+        std::fill(d + count, d + k, INFINITY);
+    }, 64);
+    return std::make_pair(indices, distances);
+}
+
+std::pair<torch::Tensor,torch::Tensor> KDTree::radius(torch::Tensor queries, float r, int max_neighbors) const
+{
+    CHECK_CPU(queries);
+    CHECK_POINTS(queries);
+    CHECK_CONTIGUOUS(queries);
+    TORCH_CHECK(0 <= r, "r must be non-negative");
+    TORCH_CHECK(0 < max_neighbors, "max_neighbors must be positive");
+    const int M = queries.size(0);
+    const int K = max_neighbors;
+    const float* queries_ptr = queries.data_ptr<float>();
+    auto indices = torch::empty({M,K}, torch::kInt32);
+    auto distances = torch::empty({M,K}, torch::kFloat32);
+    int* indices_ptr = indices.data_ptr<int>();
+    float* distances_ptr = distances.data_ptr<float>();
+    parallel_for(M, [&](int i)
+    {
+        int* idx = indices_ptr + int64_t(i) * K;
+        float* d = distances_ptr + int64_t(i) * K;
+        const int count = search_radius(queries_ptr + 3*i, r, K, idx, d);
+        for(int j = 0; j < count; ++j)
+            d[j] = std::sqrt(d[j]);
+        std::fill(idx + count, idx + K, -1);
+        std::fill(d + count, d + K, INFINITY);
+    }, 64);
+    return std::make_pair(indices, distances);
+}
+
+int KDTree::search_knn(const float* q, int k, int* idx, float* d2) const
+{
+    return search(q, k, INFINITY, idx, d2);
+}
+
+int KDTree::search_radius(const float* q, float r, int k, int* idx, float* d2) const
+{
+    return search(q, k, r * r, idx, d2);
+}
+
+int KDTree::size() const
+{
+    return m_indices.size();
+}
+
+int KDTree::search(const float* q, int k, float max_d2, int* idx, float* d2) const
+{
+    if(m_indices.empty())
+        return 0;
+    const float qx = q[0];
+    const float qy = q[1];
+    const float qz = q[2];
+    internal::KnnHeap heap(idx, d2, k, max_d2);
+
+    // stack of (node, squared distance to its half-space)
+    std::pair<int,float> stack[64];
+    int top = 0;
+    stack[top++] = {0, 0.f};
+    constexpr int block = 64;
+    float buffer[block];
+    while(0 < top)
+    {
+        const auto [n, plane_d2] = stack[--top];
+        if(heap.worst() < plane_d2)
+            continue;
+        const Node& node = m_nodes[n];
+        if(node.left < 0)
+        {
+            for(int b = node.begin; b < node.end; b += block)
+            {
+                const int size = std::min(block, node.end - b);
+                for(int j = 0; j < size; ++j) {
+                    const float dx = m_x[b+j] - qx;
+                    const float dy = m_y[b+j] - qy;
+                    const float dz = m_z[b+j] - qz;
+                    buffer[j] = dx*dx + dy*dy + dz*dz;
+                }
+                for(int j = 0; j < size; ++j)
+                    heap.push(b + j, buffer[j]);
+            }
+        }
+        else
+        {
+            const float diff = q[node.dim] - node.split;
+            const int near = diff < 0 ? node.left : node.left + 1;
+            const int far  = diff < 0 ? node.left + 1 : node.left;
+            if(diff * diff <= heap.worst())
+                stack[top++] = {far, diff * diff};
+            stack[top++] = {near, plane_d2};
+        }
+    }
+
+    const int count = heap.sort();
+    for(int j = 0; j < count; ++j)
+        idx[j] = m_indices[idx[j]];
+    return count;
+}
+
+} // namespace torch_points
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// KD-tree over 3D points
+//
+// nodes are split at the median along the axis of largest extent until
+// they contain at most leaf_size points, the tree is built in parallel
+// level by level and stored in a flat array
+// points are copied in leaf order with one array per coordinate, so that
+// the distances in a leaf are computed by a vectorized loop
+//
+// knn(queries, k)
+//      indices:   int (M,k):   indices in points, sorted by distance, -1 if less than k points
+//      distances: float (M,k): euclidean distances, inf if less than k points
+//
+// radius(queries, r, max_neighbors)
+//      indices:   int (M,K):   indices in points of the K=max_neighbors nearest neighbors
+//                              at distance at most r, sorted by distance, -1 padded
+//      distances: float (M,K): euclidean distances, inf padded
+//
+class KDTree
+{
+public:
+    KDTree(torch::Tensor points, int leaf_size = 16);
+
+    std::pair<torch::Tensor,torch::Tensor> knn(torch::Tensor queries, int k) const;
+    std::pair<torch::Tensor,torch::Tensor> radius(torch::Tensor queries, float r, int max_neighbors) const;
+
+    // single query versions, indices/squared distances are written by increasing
+    // distance in idx/d2 (of size k), the number of neighbors found is returned
+    int search_knn(const float* q, int k, int* idx, float* d2) const;
+    int search_radius(const float* q, float r, int k, int* idx, float* d2) const;
+
+    int size() const;
+
+protected:
+    struct Node
+    {
+        int begin;
+        int end;
+        int left;   // -1 for leaves, right child is left+1
+        int dim;
+        float split;
+    };
+
+    int search(const float* q, int k, float max_d2, int* idx, float* d2) const;
+
+protected:
+    int m_leaf_size;
+    std::vector<Node> m_nodes; // m_nodes[0] is the root
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<int> m_indices;
+};
+
+} // namespace torch_points
@@ -0,0 +1,287 @@
+#include <torch_points/spatial/orthtree.h>
+#include <torch_points/spatial/internal/morton.h>
+#include <torch_points/spatial/internal/box.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/parallel.h>
+#include <torch_points/common/radix_sort.h>
+
+namespace torch_points {
+
+template<int D>
+Orthtree<D>::Orthtree(torch::Tensor points, int max_points, int max_depth) :
+    m_max_points(max_points),
+    m_max_depth(max_depth < 0 ? internal::Morton<D>::max_bits : max_depth),
+    m_min{0, 0, 0},
+    m_size(1),
+    m_nodes(),
+    m_leaf_nodes(),
+    m_indices(),
+    m_leaves()
+{
+    CHECK_CPU(points);
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    TORCH_CHECK(0 < points.size(0), "points must not be empty");
+    TORCH_CHECK(0 < max_points, "max_points must be positive");
+    TORCH_CHECK(m_max_depth <= internal::Morton<D>::max_bits, 
+        "max_depth must be at most ", internal::Morton<D>::max_bits);
+    const int N = points.size(0);
+    const int B = m_max_depth;
+    const float* points_ptr = points.data_ptr<float>();
+
+    // 1. root cube
+    const internal::Box box = internal::bounding_box(points_ptr, N);
+    float size = 0;
+    for(int k = 0; k < D; ++k) {
+        m_min[k] = box.min[k];
+        size = std::max(size, box.max[k] - box.min[k]);
+    }
+    m_size = 0 < size ? size : 1;
+    for(int k = 0; k < D; ++k)
+        while(double(m_min[k]) + double(m_size) < double(box.max[k]))
+            m_size = std::nextafter(m_size, std::numeric_limits<float>::infinity());
+
+    // 2. sort points by Morton code
+    std::vector<uint64_t> codes(N);
+    parallel_for(N, [&](int i)
+    {
+        uint32_t q[D];
+        quantize(points_ptr + 3*i, q);
+        codes[i] = internal::Morton<D>::encode(q);
+    }, 4096);
+    std::vector<uint64_t> sorted(N);
+    m_indices = torch::empty({N}, torch::kInt32);
+    radix_sort(codes.data(), N, D * B, sorted.data(), m_indices.data_ptr<int>());
+
+    // 3. split nodes level by level, children are ranges of sorted codes
+    constexpr int C = 1 << D;
+    m_nodes.push_back({0, N, 0, -1, 0, -1, 0});
+    std::vector<int> level = {0};
+    while(not level.empty())
+    {
+        const int L = level.size();
+        std::vector<std::array<int,C+1>> splits(L);
+        std::vector<int> counts(L + 1, 0);
+        parallel_for(L, [&](int k)
+        {
+            const Node& node = m_nodes[level[k]];
+            if(node.end - node.begin <= m_max_points or node.depth == B)
+                return;
+            const int shift = D * (B - node.depth - 1);
+            for(int c = 0; c < C; ++c)
+            {
+                const uint64_t start = ((node.prefix << D) | c) << shift;
+                splits[k][c] = std::lower_bound(
+                    sorted.data() + node.begin,
+                    sorted.data() + node.end,
+                    start) - sorted.data();
+            }
+            splits[k][C] = node.end;
+            for(int c = 0; c < C; ++c)
+                counts[k+1] += splits[k][c] < splits[k][c+1];
+        });
+        counts[0] = m_nodes.size();
+        for(int k = 0; k < L; ++k)
+            counts[k+1] += counts[k];
+        m_nodes.resize(counts[L]);
+        parallel_for(L, [&](int k)
+        {
+            Node& node = m_nodes[level[k]];
+            if(counts[k] == counts[k+1])
+                return;
+            node.first_child = counts[k];
+            node.child_count = counts[k+1] - counts[k];
+            int child = node.first_child;
+            for(int c = 0; c < C; ++c)
+            {
+                if(splits[k][c] == splits[k][c+1])
+                    continue;
+                m_nodes[child++] = {
+                    splits[k][c], 
+                    splits[k][c+1], 
+                    node.depth + 1, 
+                    -1, 
+                    0, 
+                    -1, 
+                    (node.prefix << D) | c};
+            }
+        });
+        std::vector<int> next_level(counts[L] - counts[0]);
+        std::iota(next_level.begin(), next_level.end(), counts[0]);
+        level.swap(next_level);
+    }
+
+    // 4. leaves in Morton order
+    for(int n = 0; n < int(m_nodes.size()); ++n)
+        if(m_nodes[n].first_child < 0)
+            m_leaf_nodes.push_back(n);
+    std::sort(m_leaf_nodes.begin(), m_leaf_nodes.end(), [&](int a, int b) {
+        return m_nodes[a].begin < m_nodes[b].begin;
+    });
+    const int L = m_leaf_nodes.size();
+    m_leaves = torch::empty({L,2}, torch::kInt32);
+    auto leaves_acc = m_leaves.accessor<int,2>();
+    for(int l = 0; l < L; ++l)
+    {
+        Node& node = m_nodes[m_leaf_nodes[l]];
+        node.leaf = l;
+        leaves_acc[l][0] = node.begin;
+        leaves_acc[l][1] = node.end;
+    }
+}
+
+template<int D>
+torch::Tensor Orthtree<D>::leaves() const
+{
+    return m_leaves;
+}
+
+template<int D>
+torch::Tensor Orthtree<D>::indices() const
+{
+    return m_indices;
+}
+
+template<int D>
+torch::Tensor Orthtree<D>::boxes() const
+{
+    const int L = m_leaf_nodes.size();
+    auto boxes = torch::empty({L,2*D}, torch::kFloat32);
+    auto boxes_acc = boxes.accessor<float,2>();
+    const double unit = double(m_size) / double(uint64_t(1) << m_max_depth);
+    parallel_for(L, [&](int l)
+    {
+        uint64_t lo[D], hi[D];
+        node_box(m_nodes[m_leaf_nodes[l]], lo, hi);
+        for(int k = 0; k < D; ++k) {
+            boxes_acc[l][2*k+0] = m_min[k] + lo[k] * unit;
+            boxes_acc[l][2*k+1] = m_min[k] + hi[k] * unit;
+        }
+    }, 1024);
+    return boxes;
+}
+
+template<int D>
+torch::Tensor Orthtree<D>::depths() const
+{
+    const int L = m_leaf_nodes.size();
+    auto depths = torch::empty({L}, torch::kInt32);
+    int* depths_ptr = depths.data_ptr<int>();
+    for(int l = 0; l < L; ++l)
+        depths_ptr[l] = m_nodes[m_leaf_nodes[l]].depth;
+    return depths;
+}
+
+template<int D>
+std::pair<torch::Tensor,torch::Tensor> Orthtree<D>::neighbors() const
+{
+    const int L = m_leaf_nodes.size();
+    std::vector<std::vector<int>> neighbors(L);
+    parallel_for(L, [&](int l)
+    {
+        uint64_t lo[D], hi[D];
+        node_box(m_nodes[m_leaf_nodes[l]], lo, hi);
+        std::vector<int> stack = {0};
+        while(not stack.empty())
+        {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            uint64_t nlo[D], nhi[D];
+            node_box(node, nlo, nhi);
+            bool touch = true;
+            for(int k = 0; k < D; ++k)
+                touch = touch and nlo[k] <= hi[k] and lo[k] <= nhi[k];
+            if(not touch)
+                continue;
+            if(node.first_child < 0) {
+                if(node.leaf != l)
+                    neighbors[l].push_back(node.leaf);
+            } else {
+                for(int c = 0; c < node.child_count; ++c)
+                    stack.push_back(node.first_child + c);
+            }
+        }
+        std::sort(neighbors[l].begin(), neighbors[l].end());
+    }, 64);
+
+    auto offsets = torch::empty({L+1}, torch::kInt32);
+    int* offsets_ptr = offsets.data_ptr<int>();
+    offsets_ptr[0] = 0;
+    for(int l = 0; l < L; ++l)
+        offsets_ptr[l+1] = offsets_ptr[l] + neighbors[l].size();
+    auto flat = torch::empty({offsets_ptr[L]}, torch::kInt32);
+    int* flat_ptr = flat.data_ptr<int>();
+    parallel_for(L, [&](int l)
+    {
+        std::copy(neighbors[l].begin(), neighbors[l].end(), flat_ptr + offsets_ptr[l]);
+    }, 1024);
+    return std::make_pair(offsets, flat);
+}
+
+template<int D>
+torch::Tensor Orthtree<D>::locate(torch::Tensor queries) const
+{
+    CHECK_CPU(queries);
+    CHECK_POINTS(queries);
+    CHECK_CONTIGUOUS(queries);
+    const int M = queries.size(0);
+    const int B = m_max_depth;
+    const float* queries_ptr = queries.data_ptr<float>();
+    auto leaves = torch::empty({M}, torch::kInt32);
+    int* leaves_ptr = leaves.data_ptr<int>();
+    parallel_for(M, [&](int i)
+    {
+        leaves_ptr[i] = -1;
+        uint32_t q[D];
+        if(not quantize(queries_ptr + 3*i, q))
+            return;
+        const uint64_t code = internal::Morton<D>::encode(q);
+        const Node* node = &m_nodes[0];
+        while(0 <= node->first_child)
+        {
+            const uint64_t digit = (code >> (D * (B - node->depth - 1))) & ((1 << D) - 1);
+            const uint64_t prefix = (node->prefix << D) | digit;
+            const Node* child = nullptr;
+            for(int c = 0; c < node->child_count; ++c)
+                if(m_nodes[node->first_child + c].prefix == prefix)
+                    child = &m_nodes[node->first_child + c];
+            if(child == nullptr)
+                return;
+            node = child;
+        }
+        leaves_ptr[i] = node->leaf;
+    }, 1024);
+    return leaves;
+}
+
+template<int D>
+void Orthtree<D>::node_box(const Node& node, uint64_t* lo, uint64_t* hi) const
+{
+    uint32_t q[D];
+    internal::Morton<D>::decode(node.prefix, q);
+    const int shift = m_max_depth - node.depth;
+    for(int k = 0; k < D; ++k) {
+        lo[k] = uint64_t(q[k]) << shift;
+        hi[k] = (uint64_t(q[k]) + 1) << shift;
+    }
+}
+
+template<int D>
+bool Orthtree<D>::quantize(const float* point, uint32_t* q) const
+{
+    const double cells = double(uint64_t(1) << m_max_depth);
+    const double max_q = cells - 1;
+    bool inside = true;
+    for(int k = 0; k < D; ++k)
+    {
+        const double t = (double(point[k]) - m_min[k]) / m_size;
+        inside = inside and 0 <= t and t <= 1;
+        q[k] = static_cast<uint32_t>(std::min(std::max(std::floor(t * cells), 0.0), max_q));
+    }
+    return inside;
+}
+
+template class Orthtree<2>;
+template class Orthtree<3>;
+
+} // namespace torch_points
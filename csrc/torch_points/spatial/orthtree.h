@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// adaptive quadtree (D=2, on x/y) or octree (D=3) over 3D points
+//
+// the root is the bounding cube of the points, a node is split into 2^D
+// children while it contains more than max_points points and is shallower
+// than max_depth, empty children are not stored
+//
+// points are not modified, the tree is built in parallel level by level
+// from the points sorted by Morton code, so each node is a range of indices
+//
+// leaves:  int (L,2):     begin/end indices, leaves are in Morton order
+// indices: int (N):       indices in points
+// boxes:   float (L,2*D): xmin/xmax/ymin/ymax(/zmin/zmax) of each leaf
+// depths:  int (L):       depth of each leaf
+//
+// neighbors() returns, in CSR format, the leaves touching each leaf
+//      offsets:   int (L+1)
+//      neighbors: int (E):   leaves offsets[l]:offsets[l+1] touch the leaf l
+//
+// locate(queries) returns int (M) the leaf containing each query, -1 if none
+//
+template<int D>
+class Orthtree
+{
+public:
+    Orthtree(torch::Tensor points, int max_points = 32, int max_depth = -1);
+
+    torch::Tensor leaves() const;
+    torch::Tensor indices() const;
+    torch::Tensor boxes() const;
+    torch::Tensor depths() const;
+
+    std::pair<torch::Tensor,torch::Tensor> neighbors() const;
+    torch::Tensor locate(torch::Tensor queries) const;
+
+protected:
+    struct Node
+    {
+        int begin;
+        int end;
+        int depth;
+        int first_child;    // -1 for leaves
+        int child_count;
+        int leaf;           // leaf index, -1 for internal nodes
+        uint64_t prefix;    // Morton code of the node at its depth
+    };
+
+    // integer box of a node in units of the deepest level, [lo,hi)
+    void node_box(const Node& node, uint64_t* lo, uint64_t* hi) const;
+
+    // quantized coordinates in [0,2^max_depth), false if out of the root cube
+    bool quantize(const float* point, uint32_t* q) const;
+
+protected:
+    int m_max_points;
+    int m_max_depth;
+    float m_min[3];
+    float m_size;               // side of the root cube
+
+    std::vector<Node> m_nodes;  // m_nodes[0] is the root
+    std::vector<int> m_leaf_nodes;
+
+    torch::Tensor m_indices;
+    torch::Tensor m_leaves;
+};
+
+using Quadtree = Orthtree<2>;
+using Octree   = Orthtree<3>;
+
+} // namespace torch_points
@@ -1,6 +1,29 @@
 #include <torch_points/io/ply.h>
 #include <torch_points/io/txt.h>
 #include <torch_points/spatial/grid2D.h>
+#include <torch_points/spatial/grid2D_reduce.h>
+#include <torch_points/spatial/grid2D_patches.h>
+#include <torch_points/spatial/dynamic_grid2D.h>
+#include <torch_points/spatial/orthtree.h>
+#include <torch_points/spatial/kdtree.h>
+#include <torch_points/spatial/graph.h>
+#include <torch_points/spatial/ball_query.h>
+#include <torch_points/spatial/curves.h>
+#include <torch_points/sampling/random.h>
+#include <torch_points/sampling/fps.h>
+#include <torch_points/sampling/poisson.h>
+#include <torch_points/sampling/voxel.h>
+#include <torch_points/sampling/mesh.h>
+#include <torch_points/features/normals.h>
+#include <torch_points/features/interpolate.h>
+#include <torch_points/filtering/outliers.h>
+#include <torch_points/filtering/crop.h>
+#include <torch_points/metrics/chamfer.h>
+#include <torch_points/segmentation/clusters.h>
+#include <torch_points/registration/icp.h>
+#include <torch_points/transforms/transform.h>
+#include <torch_points/collate/pad.h>
+#include <torch_points/pipeline/pipeline.h>
 #include <torch_points/dummy/dummy.h>
 
 using namespace torch_points;
@@ -15,6 +38,95 @@ PYBIND11_MODULE(TORCH_EXTENSION_NAME, m)
     m.def("read_txt",         &read_txt);
     // ----------------------------------------------------
     m.def("build_grid2d",     &build_grid2d);
+    m.def("build_grid2d_batch", &build_grid2d_batch);
+    m.def("build_grid2d_auto", &build_grid2d_auto);
+    m.def("grid2d_reduce",    &grid2d_reduce);
+    m.def("grid2d_rasterize", &grid2d_rasterize);
+    m.def("grid2d_to_patches", &grid2d_to_patches);
+    m.def("knn_graph",        &knn_graph);
+    m.def("radius_graph",     &radius_graph);
+    m.def("ball_query",       &ball_query);
+    m.def("morton_encode",    &morton_encode);
+    m.def("hilbert_encode",   &hilbert_encode);
+    m.def("spatial_sort",     &spatial_sort);
+    py::class_<DynamicGrid2D>(m, "DynamicGrid2D")
+        .def(py::init<float,float,float,float,int,int,int>())
+        .def("insert",        &DynamicGrid2D::insert)
+        .def("remove",        &DynamicGrid2D::remove)
+        .def("compact",       &DynamicGrid2D::compact)
+        .def("cells",         &DynamicGrid2D::cells)
+        .def("indices",       &DynamicGrid2D::indices)
+        .def("points",        &DynamicGrid2D::points)
+        .def("size",          &DynamicGrid2D::size)
+        .def("garbage",       &DynamicGrid2D::garbage);
+    py::class_<Quadtree>(m, "Quadtree")
+        .def(py::init<torch::Tensor,int,int>())
+        .def("leaves",        &Quadtree::leaves)
+        .def("indices",       &Quadtree::indices)
+        .def("boxes",         &Quadtree::boxes)
+        .def("depths",        &Quadtree::depths)
+        .def("neighbors",     &Quadtree::neighbors)
+        .def("locate",        &Quadtree::locate);
+    py::class_<Octree>(m, "Octree")
+        .def(py::init<torch::Tensor,int,int>())
+        .def("leaves",        &Octree::leaves)
+        .def("indices",       &Octree::indices)
+        .def("boxes",         &Octree::boxes)
+        .def("depths",        &Octree::depths)
+        .def("neighbors",     &Octree::neighbors)
+        .def("locate",        &Octree::locate);
+    py::class_<KDTree>(m, "KDTree")
+        .def(py::init<torch::Tensor,int>())
+        .def("knn",           &KDTree::knn)
+        .def("radius",        &KDTree::radius)
+        .def("size",          &KDTree::size);
+    // ----------------------------------------------------
+    m.def("sample_points_random", &sample_points_random);
+    m.def("sample_points_fps", &sample_points_fps);
+    m.def("sample_points_poisson", &sample_points_poisson);
+    m.def("voxel_downsample", &voxel_downsample);
+    m.def("sample_mesh_surface", &sample_mesh_surface);
+    // ----------------------------------------------------
+    m.def("estimate_normals", &estimate_normals);
+    m.def("covariance_features", &covariance_features);
+    m.def("three_interpolate", &three_interpolate);
+    m.def("three_interpolate_backward", &three_interpolate_backward);
+    // ----------------------------------------------------
+    m.def("remove_statistical_outliers", &remove_statistical_outliers);
+    m.def("remove_radius_outliers", &remove_radius_outliers);
+    m.def("crop_box", &crop_box);
+    m.def("crop_obb", &crop_obb);
+    m.def("crop_polygon", &crop_polygon);
+    // ----------------------------------------------------
+    m.def("chamfer_distance", &chamfer_distance);
+    m.def("chamfer_distance_backward", &chamfer_distance_backward);
+    // ----------------------------------------------------
+    m.def("euclidean_clusters", &euclidean_clusters);
+    // ----------------------------------------------------
+    m.def("icp", &icp);
+    py::class_<ICP>(m, "ICP")
+        .def(py::init<torch::Tensor,torch::optional<torch::Tensor>>())
+        .def("align",         &ICP::align);
+    // ----------------------------------------------------
+    m.def("transform_points", &transform_points);
+    // ----------------------------------------------------
+    m.def("pad_batch", &pad_batch);
+    m.def("unpad", &unpad);
+    // ----------------------------------------------------
+    py::class_<Pipeline>(m, "Pipeline")
+        .def(py::init<int>())
+        .def("crop_box",      &Pipeline::crop_box)
+        .def("crop_obb",      &Pipeline::crop_obb)
+        .def("crop_polygon",  &Pipeline::crop_polygon)
+        .def("transform",     &Pipeline::transform)
+        .def("voxel_downsample", &Pipeline::voxel_downsample)
+        .def("remove_statistical_outliers", &Pipeline::remove_statistical_outliers)
+        .def("remove_radius_outliers", &Pipeline::remove_radius_outliers)
+        .def("normalize",     &Pipeline::normalize)
+        .def("grid2d",        &Pipeline::grid2d)
+        .def("run",           &Pipeline::run)
+        .def("run_ply",       &Pipeline::run_ply)
+        .def("timings",       &Pipeline::timings);
     // ----------------------------------------------------
     m.def("dummy",            &dummy);
     // ----------------------------------------------------
@@ -0,0 +1,152 @@
+#include <torch_points/transforms/transform.h>
+#include <torch_points/common/dispatch.h>
+#include <torch_points/common/check.h>
+#include <torch_points/common/batch.h>
+#include <torch_points/common/hash.h>
+
+namespace torch_points {
+
+namespace {
+
+// affine transform and, with normals, normal matrix (inverse transpose) of a sample
+struct Affine
+{
+    float A[3][3];
+    float t[3];
+    float N[3][3];
+
+    Affine(const double* m, bool with_normals)
+    {
+        double a[3][3];
+        for(int i = 0; i < 3; ++i) {
+            for(int j = 0; j < 3; ++j)
+                a[i][j] = m[4*i+j];
+            t[i] = m[4*i+3];
+        }
+        for(int i = 0; i < 3; ++i)
+        for(int j = 0; j < 3; ++j)
+            A[i][j] = a[i][j];
+        if(not with_normals)
+            return;
+
+        // inverse transpose = cofactor matrix / determinant
+        double c[3][3];
+        for(int i = 0; i < 3; ++i)
+        for(int j = 0; j < 3; ++j)
+        {
+            const int i1 = (i+1) % 3, i2 = (i+2) % 3;
+            const int j1 = (j+1) % 3, j2 = (j+2) % 3;
+            c[i][j] = a[i1][j1] * a[i2][j2] - a[i1][j2] * a[i2][j1];
+        }
+        const double det = a[0][0] * c[0][0] + a[0][1] * c[0][1] + a[0][2] * c[0][2];
+        TORCH_CHECK(det != 0, "matrices must be invertible to transform normals");
+        for(int i = 0; i < 3; ++i)
+        for(int j = 0; j < 3; ++j)
+            N[i][j] = c[i][j] / det;
+    }
+};
+
+} // anonymous namespace
+
+std::pair<torch::Tensor,torch::optional<torch::Tensor>> transform_points(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> normals,
+    torch::Tensor matrices,
+    torch::optional<torch::Tensor> batch,
+    float jitter,
+    int64_t seed,
+    bool inplace)
+{
+    CHECK_POINTS(points);
+    CHECK_CONTIGUOUS(points);
+    if(normals.has_value()) {
+        CHECK_POINTS(normals.value());
+        CHECK_CONTIGUOUS(normals.value());
+        TORCH_CHECK(normals->size(0) == points.size(0), "normals must have the size of points");
+    }
+    TORCH_CHECK((matrices.dim() == 2 or matrices.dim() == 3) 
+        and matrices.size(-2) == 4 and matrices.size(-1) == 4, "matrices must have size [4,4] or [B,4,4]");
+    TORCH_CHECK(0 <= jitter, "jitter must be non-negative");
+    DISPATCH(points.device(), transform_points, points, normals, matrices, batch, jitter, seed, inplace);
+}
+
+std::pair<torch::Tensor,torch::optional<torch::Tensor>> transform_points_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> normals,
+    torch::Tensor matrices,
+    torch::optional<torch::Tensor> batch,
+    float jitter,
+    int64_t seed,
+    bool inplace)
+{
+    CHECK_CPU(points);
+    CHECK_CPU(matrices);
+    if(normals.has_value())
+        CHECK_CPU(normals.value());
+    const int N = points.size(0);
+    const std::vector<int> offsets = batch_to_offsets(batch, N);
+    const int B = offsets.size() - 1;
+    const int M = matrices.dim() == 2 ? 1 : matrices.size(0);
+    TORCH_CHECK(M == 1 or M == B, "matrices must have size [4,4] or [B,4,4]");
+
+    const auto matrices64 = matrices.to(torch::kFloat64).contiguous();
+    const double* matrices_ptr = matrices64.data_ptr<double>();
+    std::vector<Affine> affines;
+    for(int m = 0; m < M; ++m)
+        affines.emplace_back(matrices_ptr + 16 * m, normals.has_value());
+
+    auto out_points = inplace ? points : torch::empty({N,3}, torch::kFloat32);
+    torch::optional<torch::Tensor> out_normals;
+    if(normals.has_value())
+        out_normals = inplace ? normals.value() : torch::empty({N,3}, torch::kFloat32);
+    const float* points_ptr = points.data_ptr<float>();
+    const float* normals_ptr = normals.has_value() ? normals->data_ptr<float>() : nullptr;
+    float* out_points_ptr = out_points.data_ptr<float>();
+    float* out_normals_ptr = normals.has_value() ? out_normals->data_ptr<float>() : nullptr;
+
+    // one parallel pass over all the points, the sample of each point selects its matrix
+    const std::vector<int> sample = M == 1 ? std::vector<int>() : offsets_to_batch(offsets);
+    at::parallel_for(0, N, 4096, [&](int64_t begin, int64_t end)
+    {
+        for(int64_t i = begin; i < end; ++i)
+        {
+            const Affine& T = affines[M == 1 ? 0 : sample[i]];
+            const float* p = points_ptr + 3 * i;
+            float q[3];
+            for(int d = 0; d < 3; ++d)
+                q[d] = T.A[d][0] * p[0] + T.A[d][1] * p[1] + T.A[d][2] * p[2] + T.t[d];
+            if(0 < jitter)
+            {
+                // Box-Muller, 4 gaussian values from 2 hashes, 3 are used
+                float g[4];
+                for(int k = 0; k < 2; ++k) {
+                    const uint64_t h = hash64(seed, 2 * uint64_t(i) + k);
+                    const float r = std::sqrt(-2 * std::log(hash_uniform(h)));
+                    const float theta = 2 * float(M_PI) * hash_uniform(h << 24);
+                    g[2*k] = r * std::cos(theta);
+                    g[2*k+1] = r * std::sin(theta);
+                }
+                for(int d = 0; d < 3; ++d)
+                    q[d] += jitter * g[d];
+            }
+            float* out = out_points_ptr + 3 * i;
+            for(int d = 0; d < 3; ++d)
+                out[d] = q[d];
+            if(normals_ptr == nullptr)
+                continue;
+
+            const float* n = normals_ptr + 3 * i;
+            float m[3];
+            for(int d = 0; d < 3; ++d)
+                m[d] = T.N[d][0] * n[0] + T.N[d][1] * n[1] + T.N[d][2] * n[2];
+            const float norm = std::sqrt(m[0]*m[0] + m[1]*m[1] + m[2]*m[2]);
+            const float scale = 0 < norm ? std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]) / norm : 0;
+            float* out_n = out_normals_ptr + 3 * i;
+            for(int d = 0; d < 3; ++d)
+                out_n[d] = m[d] * scale;
+        }
+    });
+    return std::make_pair(out_points, out_normals);
+}
+
+} // namespace torch_points
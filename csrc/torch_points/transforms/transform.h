@@ -0,0 +1,43 @@
+#pragma once
+
+#include <torch/extension.h>
+
+namespace torch_points {
+
+//
+// affine transform of batches of points, with their normals and a random jitter,
+// in a single pass over the points
+//
+// points:   float (N,3)
+// normals:  optional float (N,3), the matrices must then be invertible
+// matrices: float (4,4) or (B,4,4): affine transform of each sample, the last row is ignored
+// batch:    optional sorted batch vector (N) of any integer dtype, all the points
+//           are in one sample by default
+// jitter:   standard deviation of the gaussian noise added to the transformed points
+// seed:     the noise of the point i is the i-th value of the stream of seed, so it
+//           does not depend on the number of threads
+// inplace:  the results are written in points and normals
+//
+// returns
+//      points:  float (N,3): A p + t + noise
+//      normals: float (N,3): A^-T n rescaled to the length of n
+//
+std::pair<torch::Tensor,torch::optional<torch::Tensor>> transform_points(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> normals,
+    torch::Tensor matrices,
+    torch::optional<torch::Tensor> batch,
+    float jitter,
+    int64_t seed,
+    bool inplace);
+
+std::pair<torch::Tensor,torch::optional<torch::Tensor>> transform_points_cpu(
+    torch::Tensor points,
+    torch::optional<torch::Tensor> normals,
+    torch::Tensor matrices,
+    torch::optional<torch::Tensor> batch,
+    float jitter,
+    int64_t seed,
+    bool inplace);
+
+} // namespace torch_points
@@ -0,0 +1,41 @@
+import torch
+from torch_points import ball_query
+
+
+def check(points, centroids, indices, counts, r, K):
+    dist = torch.cdist(centroids, points)
+    for i in range(len(centroids)):
+        n = min(K, int((dist[i] <= r).sum()))
+        assert counts[i] == n
+        if n == 0:
+            assert (indices[i] == -1).all()
+            continue
+        neighbors = indices[i].long()
+        ref = dist[i].sort().values[:n]
+        assert torch.allclose(dist[i,neighbors[:n]], ref, atol=1e-5)
+        assert (neighbors[n:] == neighbors[0]).all()
+
+
+def test_ball_query():
+    r = 0.5
+    K = 8
+    points = torch.randn([500,3])
+    centroids = torch.cat([points[:50], torch.full([1,3], 10.)])
+    indices, counts = ball_query(points, centroids, r, K)
+    assert indices.shape == (51,K)
+    assert indices.dtype == torch.int32
+    assert counts.shape == (51,)
+    check(points, centroids, indices, counts, r, K)
+    assert counts[-1] == 0
+
+
+def test_ball_query_batch():
+    r = 0.4
+    K = 16
+    points = torch.randn([3,200,3])
+    centroids = points[:,:40].contiguous()
+    indices, counts = ball_query(points, centroids, r, K)
+    assert indices.shape == (3,40,K)
+    assert counts.shape == (3,40)
+    for b in range(3):
+        check(points[b], centroids[b], indices[b], counts[b], r, K)
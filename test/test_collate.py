@@ -0,0 +1,43 @@
+import torch
+from torch_points import pad_batch, unpad
+
+
+def test_pad_batch():
+    samples = [torch.randn([n,3]) for n in [5, 0, 300, 1]]
+    for mode in ['zero', 'repeat', 'random']:
+        padded, mask = pad_batch(samples, mode=mode, seed=1)
+        assert padded.shape == (4,300,3)
+        assert mask.shape == (4,300)
+        for b, sample in enumerate(samples):
+            n = len(sample)
+            assert mask[b,:n].all() and not mask[b,n:].any()
+            assert torch.equal(padded[b,:n], sample)
+            if mode == 'zero' or n == 0:
+                assert (padded[b,n:] == 0).all()
+            elif mode == 'repeat':
+                assert torch.equal(padded[b,n:], sample[torch.arange(n,300) % n])
+            else:
+                # each padding row is a row of the sample
+                assert (padded[b,n:,None] == sample[None]).all(-1).any(-1).all()
+
+
+def test_pad_batch_offsets():
+    values = torch.randint(100, [50,2,2])
+    offsets = torch.tensor([0, 20, 50], dtype=torch.int32)
+    padded, mask = pad_batch(values, offsets, Nmax=25)
+    assert padded.shape == (2,25,2,2)
+    assert padded.dtype == values.dtype
+    assert torch.equal(padded[0,:20], values[:20])
+    assert torch.equal(padded[1], values[20:45])  # truncated
+    assert mask[1].all()
+    unpadded, unpadded_offsets = unpad(padded, mask)
+    assert unpadded_offsets.tolist() == [0, 20, 45]
+    assert torch.equal(unpadded, torch.cat([values[:20], values[20:45]]))
+
+
+def test_unpad():
+    samples = [torch.randn([n,4]) for n in [7, 3, 0, 12]]
+    padded, mask = pad_batch(samples, mode='repeat')
+    values, offsets = unpad(padded, torch.tensor([7, 3, 0, 12]))
+    assert torch.equal(values, torch.cat(samples))
+    assert offsets.tolist() == [0, 7, 10, 10, 22]
@@ -0,0 +1,46 @@
+import torch
+from torch_points import morton_encode, hilbert_encode, spatial_sort
+
+
+def quantize(points, bits):
+    bounds = torch.tensor([0., 1., 0., 1., 0., 1.])
+    q = (points * 2**bits).floor().long().clamp(0, 2**bits - 1)
+    return bounds, q
+
+
+def test_morton_encode():
+    bits = 4
+    points = torch.rand([1000,3])
+    bounds, q = quantize(points, bits)
+    codes = morton_encode(points, bounds, bits)
+    assert codes.dtype == torch.int64
+    ref = torch.zeros(1000, dtype=torch.int64)
+    for b in range(bits):
+        for d in range(3):
+            ref |= ((q[:,d] >> b) & 1) << (3*b + d)
+    assert torch.equal(codes, ref)
+
+
+def test_hilbert_encode():
+    bits = 3
+    n = 2**bits
+    # centers of all the cells
+    grid = torch.stack(torch.meshgrid([torch.arange(n)]*3, indexing='ij'), -1).reshape(-1,3)
+    points = (grid.float() + 0.5) / n
+    bounds, _ = quantize(points, bits)
+    codes = hilbert_encode(points, bounds, bits)
+    assert torch.equal(codes.sort().values, torch.arange(n**3))
+    # consecutive cells are adjacent
+    path = grid[codes.argsort()]
+    assert ((path[1:] - path[:-1]).abs().sum(1) == 1).all()
+
+
+def test_spatial_sort():
+    points = torch.rand([5000,3])
+    colors = torch.rand([5000,3])
+    for curve, encode in [('morton', morton_encode), ('hilbert', hilbert_encode)]:
+        permutation, sorted_points, sorted_colors = spatial_sort(points, [colors], curve, bits=8)
+        codes = encode(points, bits=8)
+        assert (codes[permutation].diff() >= 0).all()
+        assert torch.equal(sorted_points, points[permutation])
+        assert torch.equal(sorted_colors, colors[permutation])
@@ -0,0 +1,61 @@
+import torch
+from torch_points import DynamicGrid2D
+
+
+def check_grid(grid, live, xmin, ymin, dx, dy, Nx, Ny):
+    cells = grid.cells()
+    indices = grid.indices()
+    points = grid.points()
+    seen = set()
+    for i in range(Nx):
+        for j in range(Ny):
+            cell_begin,cell_end = cells[i,j]
+            cell_begin,cell_end = cell_begin.item(),cell_end.item()
+            assert cell_begin <= cell_end
+            for k in range(cell_begin,cell_end):
+                idx = indices[k].item()
+                assert idx in live
+                assert idx not in seen
+                seen.add(idx)
+                x,y = points[idx,0].item(),points[idx,1].item()
+                assert xmin + i*dx <= x and x < xmin + i*dx + dx
+                assert ymin + j*dy <= y and y < ymin + j*dy + dy
+    assert seen == live
+    assert grid.size() == len(live)
+
+
+def test_dynamic_grid2d():
+    Nx = 8
+    Ny = 5
+    xmin = -100
+    xmax = 100
+    ymin = -50
+    ymax = 50
+    dx = (xmax - xmin) / Nx
+    dy = (ymax - ymin) / Ny
+    grid = DynamicGrid2D(xmin, xmax, ymin, ymax, Nx, Ny)
+    live = set()
+    history = []
+    for frame in range(10):
+        points = torch.rand([64,3])
+        points[:,0] = points[:,0]*220 -110 # some points out of the grid
+        points[:,1] = points[:,1]*110 -55
+        ids = grid.insert(points)
+        assert ids.shape == (64,)
+        for i in range(64):
+            x,y = points[i,0].item(),points[i,1].item()
+            inside = xmin <= x and x < xmax and ymin <= y and y < ymax
+            assert (ids[i].item() >= 0) == inside
+            if inside:
+                live.add(ids[i].item())
+                history.append(ids[i].item())
+        check_grid(grid, live, xmin, ymin, dx, dy, Nx, Ny)
+        # evict the oldest points
+        removed = history[:20]
+        history = history[20:]
+        grid.remove(torch.tensor(removed, dtype=torch.int32))
+        live -= set(removed)
+        check_grid(grid, live, xmin, ymin, dx, dy, Nx, Ny)
+    grid.compact()
+    assert grid.garbage() == 0
+    check_grid(grid, live, xmin, ymin, dx, dy, Nx, Ny)
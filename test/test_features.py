@@ -0,0 +1,57 @@
+import torch
+from torch_points import estimate_normals, covariance_features, three_interpolate
+
+
+def sphere(N):
+    points = torch.randn([N,3])
+    return points / points.norm(dim=1, keepdim=True)
+
+
+def test_estimate_normals():
+    points = sphere(2000)
+    for k, r in [(16, 0), (0, 0.2), (10, 0.2)]:
+        normals = estimate_normals(points, k, r, viewpoint=torch.zeros(3))
+        assert normals.shape == (2000,3)
+        assert torch.allclose(normals.norm(dim=1), torch.ones(2000), atol=1e-5)
+        # normals of a unit sphere oriented toward its center
+        assert ((normals * points).sum(1) < -0.98).all()
+
+
+def test_covariance_features():
+    k = 12
+    points = torch.randn([500,3])
+    eigenvalues, features = covariance_features(points, k)
+    assert eigenvalues.shape == (500,3)
+    assert features.shape == (500,4)
+    neighbors = torch.cdist(points, points).topk(k, largest=False).indices
+    local = points[neighbors]
+    local = local - local.mean(1, keepdim=True)
+    covariance = local.transpose(1,2) @ local / k
+    ref = torch.linalg.eigvalsh(covariance.double()).float()
+    assert torch.allclose(eigenvalues, ref, atol=1e-5)
+    l0, l1, l2 = ref.unbind(1)
+    assert torch.allclose(features[:,0], (l2 - l1) / l2, atol=1e-4)
+    assert torch.allclose(features[:,3], l0 / (l0 + l1 + l2), atol=1e-4)
+
+
+def test_three_interpolate():
+    dense = torch.randn([2,500,3])
+    coarse = torch.randn([2,50,3])
+    coarse_features = torch.randn([2,50,8], requires_grad=True)
+    features = three_interpolate(dense, coarse, coarse_features)
+    assert features.shape == (2,500,8)
+    # reference with cdist + topk + gather
+    ref_features = coarse_features.detach().clone().requires_grad_()
+    d2, indices = (torch.cdist(dense, coarse)**2).topk(3, largest=False)
+    weights = 1 / (d2 + 1e-8)
+    weights = weights / weights.sum(-1, keepdim=True)
+    neighbors = torch.stack([ref_features[b][indices[b]] for b in range(2)])
+    ref = (neighbors * weights.unsqueeze(-1)).sum(2)
+    assert torch.allclose(features, ref, atol=1e-5)
+    grad = torch.randn([2,500,8])
+    features.backward(grad)
+    ref.backward(grad)
+    assert torch.allclose(coarse_features.grad, ref_features.grad, atol=1e-5)
+    # unbatched, less than 3 coarse points
+    features = three_interpolate(dense[0], coarse[0,:2], coarse_features[0,:2].detach())
+    assert features.shape == (500,8)
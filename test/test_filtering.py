@@ -0,0 +1,86 @@
+import torch
+from torch_points import remove_statistical_outliers, remove_radius_outliers, crop_box, crop_obb, crop_polygon
+
+
+def make_points():
+    points = torch.randn([1000,3])
+    points[-20:] *= 10
+    return points
+
+
+def test_remove_statistical_outliers():
+    k = 8
+    std_ratio = 1.5
+    points = make_points()
+    mask, indices = remove_statistical_outliers(points, k, std_ratio)
+    assert mask.dtype == torch.bool and indices.dtype == torch.int64
+    dist = torch.cdist(points, points)
+    dist.fill_diagonal_(float('inf'))
+    mean = dist.topk(k, largest=False).values.mean(1)
+    ref = mean <= mean.mean() + std_ratio * mean.std()
+    assert torch.equal(mask, ref)
+    assert torch.equal(indices, ref.nonzero()[:,0])
+
+
+def test_remove_radius_outliers():
+    r = 0.3
+    min_neighbors = 3
+    points = make_points()
+    mask, indices = remove_radius_outliers(points, r, min_neighbors)
+    dist = torch.cdist(points, points)
+    dist.fill_diagonal_(float('inf'))
+    ref = (dist <= r).sum(1) >= min_neighbors
+    assert torch.equal(mask, ref)
+    assert torch.equal(indices, ref.nonzero()[:,0])
+
+
+def test_crop_box():
+    points = torch.randn([1000,3])
+    mask, indices = crop_box(points, [-1, 0.5, -0.2, 1, 0, 1])
+    ref = (points >= torch.tensor([-1, -0.2, 0])).all(1) & (points <= torch.tensor([0.5, 1, 1])).all(1)
+    assert torch.equal(mask, ref)
+    assert torch.equal(indices, ref.nonzero().squeeze(1))
+
+
+def test_crop_obb():
+    points = torch.randn([1000,3])
+    angle = torch.tensor(0.3)
+    rotation = torch.tensor([
+        [torch.cos(angle), -torch.sin(angle), 0],
+        [torch.sin(angle), torch.cos(angle), 0],
+        [0, 0, 1]])
+    center = torch.tensor([0.1, 0.2, 0.3])
+    extent = torch.tensor([1, 0.5, 0.8])
+    mask, indices = crop_obb(points, center, rotation, extent)
+    local = (points - center) @ rotation
+    ref = (local.abs() <= extent / 2).all(1)
+    assert torch.equal(mask, ref)
+    assert torch.equal(indices, ref.nonzero().squeeze(1))
+
+
+def ray_casting(points, polygon):
+    x, y = points[:,0:1], points[:,1:2]
+    x0, y0 = polygon[:,0], polygon[:,1]
+    x1, y1 = polygon.roll(-1, 0)[:,0], polygon.roll(-1, 0)[:,1]
+    straddle = (y < y0) != (y < y1)
+    crossing = x < x0 + (y - y0) / (y1 - y0) * (x1 - x0)
+    return ((straddle & crossing).sum(1) % 2) == 1
+
+
+def test_crop_polygon():
+    points = 3 * torch.rand([20000,3]) - 1.5
+    angles = torch.linspace(0, 2 * torch.pi, 1001)[:-1]
+    radii = 0.6 + 0.4 * torch.rand(1000)
+    outer = torch.stack([radii * torch.cos(angles), radii * torch.sin(angles)], 1)
+    hole = 0.2 * torch.stack([torch.cos(-angles[::50]), torch.sin(-angles[::50])], 1)
+    mask, indices = crop_polygon(points, outer)
+    ref = ray_casting(points, outer)
+    assert (mask != ref).sum() <= 2
+    assert torch.equal(indices, mask.nonzero().squeeze(1))
+    # with a hole
+    polygon = torch.cat([outer, hole])
+    rings = torch.tensor([0, 1000, 1020], dtype=torch.int32)
+    mask, indices = crop_polygon(points, polygon, rings)
+    ref = ray_casting(points, outer) & ~ray_casting(points, hole)
+    assert (mask != ref).sum() <= 2
+    assert not mask[points[:,:2].norm(dim=1) < 0.18].any()
@@ -0,0 +1,49 @@
+import torch
+from torch_points import knn_graph, radius_graph
+
+
+def make_batch():
+    sizes = [100, 1, 60]
+    points = torch.randn([sum(sizes),3])
+    batch = torch.cat([torch.full([n], b) for b,n in enumerate(sizes)])
+    return points, batch
+
+
+def test_knn_graph():
+    k = 5
+    points, batch = make_batch()
+    N = len(points)
+    edge_index = knn_graph(points, k, batch)
+    assert edge_index.dtype == torch.int64
+    sources, targets = edge_index
+    dist = torch.cdist(points, points)
+    dist[batch[:,None] != batch[None,:]] = float('inf')
+    dist.fill_diagonal_(float('inf'))
+    for i in range(N):
+        neighbors = sources[targets == i]
+        n = min(k, int((batch == batch[i]).sum()) - 1)
+        assert len(neighbors) == n
+        ref = dist[i].sort().values[:n]
+        assert torch.allclose(dist[i,neighbors], ref, atol=1e-5)
+    # symmetric graph
+    edge_index = knn_graph(points, k, batch, symmetric=True)
+    edges = set(map(tuple, edge_index.t().tolist()))
+    assert len(edges) == edge_index.shape[1]
+    assert all((j,i) in edges for i,j in edges)
+
+
+def test_radius_graph():
+    r = 0.5
+    points, batch = make_batch()
+    N = len(points)
+    dist = torch.cdist(points, points)
+    dist[batch[:,None] != batch[None,:]] = float('inf')
+    for max_neighbors in [0, 4]:
+        sources, targets = radius_graph(points, r, batch, max_neighbors=max_neighbors, loop=True)
+        for i in range(N):
+            neighbors = sources[targets == i]
+            n = int((dist[i] <= r).sum())
+            if max_neighbors > 0:
+                n = min(n, max_neighbors)
+            assert len(neighbors) == n
+            assert (dist[i,neighbors] <= r + 1e-5).all()
@@ -1,6 +1,6 @@
 
 import torch
-from torch_points import build_grid2d
+from torch_points import build_grid2d, build_grid2d_batch, build_grid2d_auto, grid2d_reduce, grid2d_rasterize, grid2d_to_patches
 
 
 def test_grid2d():
@@ -36,3 +36,132 @@ def test_grid2d():
                 x,y,z = x.item(),y.item(),z.item()
                 assert cell_xmin <= x and x < cell_xmax
                 assert cell_ymin <= y and y < cell_ymax
+
+def test_grid2d_batch():
+    sizes = [100, 0, 37, 250]
+    B = len(sizes)
+    N = sum(sizes)
+    Nx = 6
+    Ny = 4
+    points = torch.rand([N,3])*2 -1
+    offsets = torch.tensor([0] + sizes, dtype=torch.int32).cumsum(0).to(torch.int32)
+    bounds = torch.tensor([[-1+0.1*b, 1, -1, 1-0.1*b] for b in range(B)], dtype=torch.float32)
+    cells, indices = build_grid2d_batch(points, offsets, bounds, Nx, Ny)
+    assert cells.shape == (B,Nx,Ny,2)
+    assert indices.shape == (N,)
+    assert sorted(indices.tolist()) == list(range(N))
+    for b in range(B):
+        xmin,xmax,ymin,ymax = bounds[b].tolist()
+        dx = (xmax - xmin) / Nx
+        dy = (ymax - ymin) / Ny
+        count = 0
+        for i in range(Nx):
+            for j in range(Ny):
+                cell_begin,cell_end = cells[b,i,j].tolist()
+                assert cell_begin <= cell_end
+                count += cell_end - cell_begin
+                for k in range(cell_begin,cell_end):
+                    idx = indices[k].item()
+                    assert offsets[b] <= idx and idx < offsets[b+1]
+                    x,y = points[idx,0].item(),points[idx,1].item()
+                    assert xmin + i*dx <= x and x < xmin + i*dx + dx
+                    assert ymin + j*dy <= y and y < ymin + j*dy + dy
+        if sizes[b] > 0:
+            ref_cells, _ = build_grid2d(points[offsets[b]:offsets[b+1]], xmin, xmax, ymin, ymax, Nx, Ny)
+            assert torch.equal(ref_cells[:,:,1] - ref_cells[:,:,0], cells[b,:,:,1] - cells[b,:,:,0])
+
+
+def test_grid2d_auto():
+    N = 256
+    points = torch.rand([N,3])
+    points[:,0:2] = points[:,0:2]*200 -100
+    for cell_size, points_per_cell in [(25.0, 0), (0, 8.0)]:
+        cells, indices, bounds = build_grid2d_auto(points, cell_size=cell_size, points_per_cell=points_per_cell)
+        Nx, Ny = cells.shape[0], cells.shape[1]
+        xmin, xmax, ymin, ymax = bounds.tolist()
+        assert xmin == points[:,0].min().item()
+        assert ymin == points[:,1].min().item()
+        assert points[:,0].max().item() < xmax
+        assert points[:,1].max().item() < ymax
+        if cell_size > 0:
+            assert abs((xmax - xmin) / Nx - cell_size) < 1e-3
+        # no point is dropped
+        assert (cells[:,:,1] - cells[:,:,0]).sum().item() == N
+        assert sorted(indices.tolist()) == list(range(N))
+
+
+def test_grid2d_reduce():
+    N = 2000
+    Nx = 6
+    Ny = 4
+    points = torch.randn([N,3])
+    values = torch.randn([N])
+    ops = ['count', 'min', 'max', 'mean', 'std', 'argmin', 'argmax']
+    cells, indices = build_grid2d(points, -1, 1, -1, 1, Nx, Ny)
+    reduced = grid2d_reduce(points, cells, indices, ops, values)
+    rasterized = grid2d_rasterize(points, -1, 1, -1, 1, Nx, Ny, ops, values)
+    for images in [reduced, rasterized]:
+        count, vmin, vmax, mean, std, argmin, argmax = images
+        assert count.shape == (Nx,Ny) and count.dtype == torch.int32
+        assert mean.shape == (Nx,Ny) and mean.dtype == torch.float32
+        for i in range(Nx):
+            for j in range(Ny):
+                begin, end = cells[i,j].tolist()
+                cell_indices = indices[begin:end].long()
+                v = values[cell_indices]
+                assert count[i,j] == len(v)
+                if len(v) == 0:
+                    assert mean[i,j].isnan() and argmin[i,j] == -1
+                    continue
+                assert vmin[i,j] == v.min() and vmax[i,j] == v.max()
+                assert torch.isclose(mean[i,j], v.mean(), atol=1e-5)
+                assert torch.isclose(std[i,j], v.std(unbiased=False), atol=1e-5)
+                assert values[argmin[i,j]] == v.min() and values[argmax[i,j]] == v.max()
+    # z coordinates by default
+    zmin, = grid2d_reduce(points, cells, indices, ['min'])
+    assert torch.equal(zmin, grid2d_rasterize(points, -1, 1, -1, 1, Nx, Ny, ['min'])[0])
+    # fewer points than cells, binned by a counting sort
+    cells, indices = build_grid2d(points, -1, 1, -1, 1, 100, 80)
+    reduced = grid2d_reduce(points, cells, indices, ops, values)
+    rasterized = grid2d_rasterize(points, -1, 1, -1, 1, 100, 80, ops, values)
+    for a, b in zip(reduced, rasterized):
+        assert torch.equal(a, b) or torch.allclose(a, b, atol=1e-6, equal_nan=True)
+    # infinite heights, +inf in the first cell and -inf in the second
+    points = torch.rand([1000,3])
+    points[:,2] = torch.where(points[:,0] < 0.5, float('inf'), float('-inf'))
+    first = (points[:,0] < 0.5).int().argmax().item()
+    second = (points[:,0] >= 0.5).int().argmax().item()
+    cells, indices = build_grid2d(points, 0, 1, 0, 1, 2, 1)
+    for argmin, argmax in [grid2d_reduce(points, cells, indices, ['argmin', 'argmax']),
+                           grid2d_rasterize(points, 0, 1, 0, 1, 2, 1, ['argmin', 'argmax'])]:
+        assert argmin[:,0].tolist() == [first, second]
+        assert argmax[:,0].tolist() == [first, second]
+
+
+def test_grid2d_to_patches():
+    N, Nx, Ny, K = 5000, 10, 8, 64
+    points = torch.rand([N,3])
+    points[:2000,:2] *= 0.1  # over-full cells in a corner
+    features = torch.arange(N)
+    cells, indices = build_grid2d(points, 0, 1, 0, 1, Nx, Ny)
+    patches, patch_features, patch_indices, patch_cells, mask = grid2d_to_patches(
+        points, features, cells, indices, K, min_points=30, bounds=(0, 1, 0, 1), seed=1)
+    counts = cells[:,:,1] - cells[:,:,0]
+    P = (counts >= 30).sum().item()
+    assert patches.shape == (P,K,3) and mask.shape == (P,K)
+    assert torch.equal(patch_cells.long(), (counts >= 30).nonzero())
+    assert torch.equal(patch_features, patch_indices.long())
+    for p in range(P):
+        i, j = patch_cells[p].tolist()
+        begin, end = cells[i,j].tolist()
+        n = end - begin
+        members = indices[begin:end].long()
+        assert mask[p].sum() == min(n, K)
+        valid = patch_indices[p][mask[p]].long()
+        assert torch.isin(patch_indices[p].long(), members).all()
+        assert len(valid.unique()) == len(valid)
+        center = torch.tensor([(i + 0.5) / Nx, (j + 0.5) / Ny, 0])
+        assert torch.allclose(patches[p], points[patch_indices[p].long()] - center, atol=1e-6)
+    # same seed, same patches
+    _, _, same_indices, _, _ = grid2d_to_patches(points, None, cells, indices, K, min_points=30, seed=1)
+    assert torch.equal(patch_indices, same_indices)
@@ -0,0 +1,42 @@
+import torch
+from torch_points import KDTree
+
+
+def test_kdtree_knn():
+    N = 500
+    M = 50
+    k = 8
+    points = torch.randn([N,3])
+    queries = torch.randn([M,3])
+    tree = KDTree(points, leaf_size=4)
+    assert tree.size() == N
+    indices, distances = tree.knn(queries, k)
+    assert indices.shape == (M,k)
+    assert distances.shape == (M,k)
+    ref_distances, ref_indices = torch.cdist(queries, points).topk(k, largest=False)
+    assert torch.allclose(distances, ref_distances, atol=1e-5)
+    assert torch.allclose((points[indices.long()] - queries[:,None]).norm(dim=-1), ref_distances, atol=1e-5)
+    # less points than neighbors
+    indices, distances = KDTree(points[:3]).knn(queries, 5)
+    assert (indices[:,3:] == -1).all()
+    assert torch.isinf(distances[:,3:]).all()
+
+
+def test_kdtree_radius():
+    N = 500
+    M = 50
+    K = 16
+    r = 0.5
+    points = torch.randn([N,3])
+    queries = torch.randn([M,3])
+    tree = KDTree(points)
+    indices, distances = tree.radius(queries, r, K)
+    assert indices.shape == (M,K)
+    dist = torch.cdist(queries, points)
+    for i in range(M):
+        count = min(int((dist[i] <= r).sum()), K)
+        assert (indices[i,:count] >= 0).all()
+        assert (indices[i,count:] == -1).all()
+        assert (distances[i,:count] <= r + 1e-5).all()
+        ref = dist[i].sort().values[:count]
+        assert torch.allclose(distances[i,:count], ref, atol=1e-5)
@@ -0,0 +1,46 @@
+import torch
+from torch_points import chamfer_distance
+
+
+def test_chamfer_distance():
+    a = torch.randn([300,3])
+    b = torch.randn([200,3])
+    dist_a, idx_a, dist_b, idx_b = chamfer_distance(a, b)
+    dist = torch.cdist(a, b)**2
+    assert torch.allclose(dist_a, dist.min(1).values, atol=1e-5)
+    assert torch.allclose(dist_b, dist.min(0).values, atol=1e-5)
+    assert torch.allclose(dist_a, dist[torch.arange(300),idx_a.long()], atol=1e-5)
+    assert torch.allclose(dist_b, dist[idx_b.long(),torch.arange(200)], atol=1e-5)
+
+
+def test_chamfer_distance_batch():
+    a = torch.randn([300,3])
+    b = torch.randn([200,3])
+    a_offsets = torch.tensor([0, 100, 100, 300], dtype=torch.int32)
+    b_offsets = torch.tensor([0, 50, 120, 200], dtype=torch.int32)
+    dist_a, idx_a, dist_b, idx_b = chamfer_distance(a, b, a_offsets, b_offsets)
+    for s in range(3):
+        a_s = a[a_offsets[s]:a_offsets[s+1]]
+        b_s = b[b_offsets[s]:b_offsets[s+1]]
+        if len(a_s) == 0:
+            assert torch.isinf(dist_b[b_offsets[s]:b_offsets[s+1]]).all()
+            assert (idx_b[b_offsets[s]:b_offsets[s+1]] == -1).all()
+            continue
+        dist = torch.cdist(a_s, b_s)**2
+        assert torch.allclose(dist_a[a_offsets[s]:a_offsets[s+1]], dist.min(1).values, atol=1e-5)
+        assert torch.allclose(dist_b[b_offsets[s]:b_offsets[s+1]], dist.min(0).values, atol=1e-5)
+
+
+def test_chamfer_distance_backward():
+    a = torch.randn([300,3], requires_grad=True)
+    b = torch.randn([200,3], requires_grad=True)
+    dist_a, idx_a, dist_b, idx_b = chamfer_distance(a, b)
+    (dist_a.mean() + 2 * dist_b.mean()).backward()
+    # reference with the same neighbors
+    a_ref = a.detach().clone().requires_grad_()
+    b_ref = b.detach().clone().requires_grad_()
+    dist_a_ref = ((a_ref - b_ref[idx_a.long()])**2).sum(1)
+    dist_b_ref = ((b_ref - a_ref[idx_b.long()])**2).sum(1)
+    (dist_a_ref.mean() + 2 * dist_b_ref.mean()).backward()
+    assert torch.allclose(a.grad, a_ref.grad, atol=1e-6)
+    assert torch.allclose(b.grad, b_ref.grad, atol=1e-6)
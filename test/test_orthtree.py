@@ -0,0 +1,54 @@
+import torch
+from torch_points import Quadtree, Octree
+
+
+def check_tree(tree, points, D, max_points):
+    N = len(points)
+    leaves = tree.leaves()
+    indices = tree.indices()
+    boxes = tree.boxes()
+    L = len(leaves)
+    assert leaves.shape == (L,2)
+    assert boxes.shape == (L,2*D)
+    assert sorted(indices.tolist()) == list(range(N))
+    # leaves are consecutive ranges
+    assert leaves[0,0].item() == 0
+    assert leaves[-1,1].item() == N
+    assert torch.equal(leaves[1:,0], leaves[:-1,1])
+    assert (leaves[:,1] - leaves[:,0]).max().item() <= max_points
+    for l in range(L):
+        begin,end = leaves[l].tolist()
+        for k in range(begin,end):
+            p = points[indices[k]]
+            for d in range(D):
+                assert boxes[l,2*d].item() - 1e-5 <= p[d].item()
+                assert p[d].item() <= boxes[l,2*d+1].item() + 1e-5
+    # each point is located in its leaf
+    located = tree.locate(points)
+    for l in range(L):
+        begin,end = leaves[l].tolist()
+        assert (located[indices[begin:end]] == l).all()
+    # neighbors are the leaves with touching boxes
+    offsets, neighbors = tree.neighbors()
+    assert offsets.shape == (L+1,)
+    for l in range(L):
+        touch = torch.ones(L, dtype=torch.bool)
+        for d in range(D):
+            touch &= (boxes[:,2*d] <= boxes[l,2*d+1]) & (boxes[l,2*d] <= boxes[:,2*d+1])
+        touch[l] = False
+        expected = touch.nonzero().flatten().tolist()
+        assert neighbors[offsets[l]:offsets[l+1]].tolist() == expected
+
+
+def test_quadtree():
+    points = torch.randn([500,3])
+    points[::3] *= 0.01 # dense cluster
+    tree = Quadtree(points, max_points=8)
+    check_tree(tree, points, 2, 8)
+
+
+def test_octree():
+    points = torch.randn([500,3])
+    points[::3] *= 0.01 # dense cluster
+    tree = Octree(points, max_points=8)
+    check_tree(tree, points, 3, 8)
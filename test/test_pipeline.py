@@ -0,0 +1,56 @@
+import torch
+from torch_points import Pipeline, crop_box, crop_polygon, voxel_downsample, remove_statistical_outliers, build_grid2d_auto, write_ply
+from pathlib import Path
+
+
+def test_pipeline():
+    points = 4 * torch.rand([20000,3]) - 2
+    bounds = [-1.5, 1.5, -1.5, 1.5, -1.8, 1.8]
+    matrix = torch.tensor([[0,-2,0,0.5], [1,0,0,0], [0,0,3,0], [0,0,0,1]])
+    polygon = torch.tensor([[-0.8,-0.8], [0.8,-0.8], [0.8,0.8], [-0.8,0.8]])
+    pipeline = (Pipeline(chunk_size=1000)
+        .crop_box(bounds)
+        .transform(matrix)
+        .voxel_downsample(0.1)
+        .remove_statistical_outliers(8, 1)
+        .normalize()
+        .crop_polygon(polygon)
+        .grid2d(cell_size=0.1))
+    result, cells, indices, grid_bounds = pipeline(points)
+
+    expected = points[crop_box(points, bounds)[1]] @ matrix[:3,:3].T + matrix[:3,3]
+    expected = voxel_downsample(expected, None, 0.1)[0]
+    expected = expected[remove_statistical_outliers(expected, 8, 1)[1]]
+    expected = expected - expected.mean(0)
+    expected = expected / expected.norm(dim=1).max()
+    expected = expected[crop_polygon(expected, polygon)[1]]
+    assert torch.allclose(result, expected, atol=1e-5)
+    expected_cells, expected_indices, _ = build_grid2d_auto(result, cell_size=0.1)
+    assert torch.equal(cells, expected_cells)
+    assert torch.equal(indices, expected_indices)
+    assert grid_bounds.shape == (4,)
+
+    names = [name for name, seconds in pipeline.timings]
+    assert names == ['crop_box', 'transform', 'voxel_downsample', 'remove_statistical_outliers',
+        'normalize', 'crop_polygon', 'grid2d']
+    assert all(seconds >= 0 for name, seconds in pipeline.timings)
+
+    # the decoder fills the chunks of the first pass
+    write_ply('pipeline.ply', points)
+    result_ply, cells_ply, _, _ = pipeline.read_ply('pipeline.ply')
+    assert torch.equal(result_ply, result)
+    assert torch.equal(cells_ply, cells)
+    assert pipeline.timings[0][0] == 'read_ply'
+    f = Path('pipeline.ply')
+    assert f.exists()
+    f.unlink()
+
+
+def test_pipeline_streaming():
+    points = torch.rand([5000,3])
+    pipeline = Pipeline(chunk_size=777).crop_box([0.1, 0.9, 0, 1, 0, 1]).transform(2 * torch.eye(4))
+    result, cells, indices, bounds = pipeline(points)
+    mask = (0.1 <= points[:,0]) & (points[:,0] <= 0.9)
+    assert torch.equal(result, 2 * points[mask])
+    assert cells is None and indices is None and bounds is None
+    assert [name for name, seconds in pipeline.timings] == ['crop_box', 'transform']
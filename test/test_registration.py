@@ -0,0 +1,45 @@
+import math
+import torch
+from torch_points import icp, ICP
+
+
+def surface(N):
+    # three non-parallel patches, so that the registration is well constrained
+    x, y = 2 * torch.rand([2,N]) - 1
+    floor = torch.stack([x, y, 0.3 * torch.sin(3*x) * torch.cos(2*y)], 1)
+    wall = torch.stack([x, 1 + 0.2 * x**2, y + 1], 1)
+    side = torch.stack([1 + 0.1 * y, x, y + 1], 1)
+    return torch.cat([floor, wall, side])
+
+
+def transform(angle, translation):
+    c, s = math.cos(angle), math.sin(angle)
+    T = torch.eye(4)
+    T[:3,:3] = torch.tensor([[c,-s,0], [s,c,0], [0,0,1]])
+    T[:3,3] = torch.tensor(translation)
+    return T
+
+
+def test_icp():
+    target = surface(5000)
+    T = transform(0.1, [0.05,-0.03,0.04])
+    source = (target - T[:3,3]) @ T[:3,:3]
+    for mode in ['point_to_point', 'point_to_plane']:
+        estimated, residuals = icp(source, target, max_iters=50, max_dist=0.5, mode=mode)
+        assert torch.allclose(estimated, T, atol=1e-4)
+        assert residuals[-1] < 1e-4
+        assert residuals[-1] < residuals[0]
+
+
+def test_icp_reuse():
+    target = surface(5000)
+    registration = ICP(target)
+    for angle in [0.05, -0.1]:
+        T = transform(angle, [0.02,0.01,-0.03])
+        source = (target - T[:3,3]) @ T[:3,:3]
+        estimated, _ = registration.align(source, max_dist=0.5, mode='point_to_plane')
+        assert torch.allclose(estimated, T, atol=1e-4)
+        # exact initial transform: a single iteration
+        estimated, residuals = registration.align(source, max_dist=0.5, init=T)
+        assert len(residuals) == 1
+        assert torch.allclose(estimated, T, atol=1e-5)
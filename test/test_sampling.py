@@ -0,0 +1,153 @@
+import torch
+from torch_points import sample_points_random, sample_points_fps, sample_points_poisson, voxel_downsample, sample_mesh_surface
+
+
+def fps(points, M, start_idx):
+    indices = [start_idx]
+    dist = torch.full([len(points)], float('inf'))
+    for _ in range(M-1):
+        dist = torch.minimum(dist, ((points - points[indices[-1]])**2).sum(-1))
+        dist[indices] = -1
+        indices.append(int(dist.argmax()))
+    return torch.tensor(indices, dtype=torch.int32)
+
+
+def test_sample_points_random():
+    points = torch.randn([100,3])
+    samples = sample_points_random(points, 10)
+    assert samples.shape == (10,3)
+    # reproducible with a seed
+    colors = torch.arange(200).reshape(100,2)
+    samples, sampled_colors, indices = sample_points_random(
+        points, 10, seed=3, attributes=[colors], return_indices=True)
+    assert indices.dtype == torch.int64
+    assert len(indices.unique()) == 10
+    assert torch.equal(samples, points[indices])
+    assert torch.equal(sampled_colors, colors[indices])
+    assert torch.equal(indices, sample_points_random(points, 10, seed=3, return_indices=True)[1])
+    # non-contiguous views, all the points in random order
+    view = torch.randn([3,100]).T
+    samples, indices = sample_points_random(view, 100, seed=4, return_indices=True)
+    assert torch.equal(samples, view[indices])
+    assert torch.equal(indices.sort()[0], torch.arange(100))
+    assert not torch.equal(indices, torch.arange(100))
+
+
+def test_sample_points_random_batch():
+    points = torch.randn([1000,3])
+    offsets = torch.tensor([0, 600, 610, 1000], dtype=torch.int32)
+    M = torch.tensor([5, 10, 300])
+    _, indices = sample_points_random(points, M, offsets, return_indices=True)
+    assert indices.shape == (315,)
+    for b, (begin, end) in enumerate([(0,5), (5,15), (15,315)]):
+        sample = indices[begin:end]
+        assert len(sample.unique()) == len(sample)
+        assert (offsets[b] <= sample).all() and (sample < offsets[b+1]).all()
+
+
+def test_sample_points_fps():
+    points = torch.randn([1000,3])
+    samples, indices = sample_points_fps(points, 64, start_idx=3)
+    assert samples.shape == (64,3)
+    assert indices.dtype == torch.int32
+    assert torch.equal(indices, fps(points, 64, 3))
+    assert torch.equal(samples, points[indices.long()])
+
+
+def test_sample_points_fps_batch():
+    M = 16
+    points = torch.randn([300,3])
+    offsets = torch.tensor([0, 100, 120, 300], dtype=torch.int32)
+    _, indices = sample_points_fps(points, M, offsets=offsets)
+    assert indices.shape == (3*M,)
+    for b in range(3):
+        begin, end = offsets[b].item(), offsets[b+1].item()
+        ref = fps(points[begin:end], M, 0) + begin
+        assert torch.equal(indices[b*M:(b+1)*M], ref)
+
+
+def test_sample_points_fps_approximate():
+    M = 32
+    points = torch.randn([20000,3])
+    _, indices = sample_points_fps(points, M, start_idx=5, approximate=True)
+    assert indices[0] == 5
+    assert len(indices.unique()) == M
+    # the coverage radius is close to the exact one
+    exact = fps(points, M, 5).long()
+    radius = lambda idx: torch.cdist(points, points[idx]).min(1).values.max()
+    assert radius(indices.long()) < 1.5 * radius(exact)
+
+
+def test_sample_points_poisson():
+    r = 0.3
+    points = torch.randn([2000,3])
+    samples, indices = sample_points_poisson(points, r, seed=1)
+    assert (indices.diff() > 0).all()
+    assert torch.equal(samples, points[indices.long()])
+    dist = torch.cdist(samples, samples)
+    dist.fill_diagonal_(float('inf'))
+    assert (dist >= r - 1e-5).all()
+    # maximal: every point is close to a sample
+    assert (torch.cdist(points, samples).min(1).values < r + 1e-5).all()
+    assert torch.equal(indices, sample_points_poisson(points, r, seed=1)[1])
+
+
+def test_voxel_downsample():
+    voxel_size = 0.3
+    points = torch.randn([2000,3])
+    features = torch.randn([2000,4])
+    voxels = ((points - points.min(0).values) / voxel_size).floor().long()
+    keys, ref_inverse = voxels.unique(dim=0, return_inverse=True)
+    V = len(keys)
+    counts = torch.bincount(ref_inverse, minlength=V)[:,None]
+    centroids = torch.zeros([V,3]).index_add_(0, ref_inverse, points) / counts
+    means = torch.zeros([V,4]).index_add_(0, ref_inverse, features) / counts
+    for mode in ['mean', 'first', 'nearest']:
+        out_points, out_features, inverse = voxel_downsample(points, features, voxel_size, mode)
+        assert out_points.shape == (V,3)
+        # same partition as the reference, up to the order of the voxels
+        perm = torch.empty(V, dtype=torch.long)
+        perm[ref_inverse] = inverse.long()
+        assert torch.equal(perm[ref_inverse], inverse.long())
+        assert torch.allclose(out_features[perm], means, atol=1e-5)
+        if mode == 'mean':
+            assert torch.allclose(out_points[perm], centroids, atol=1e-5)
+        else:
+            # output points are input points of their voxel
+            selected = (out_points[inverse.long()] == points).all(1)
+            assert selected.sum() == V
+        # voxels are numbered in the order of their first point
+        firsts = torch.full([V], len(points), dtype=torch.long).scatter_reduce_(
+            0, inverse.long(), torch.arange(len(points)), 'amin')
+        assert (firsts[1:] > firsts[:-1]).all()
+        if mode == 'first':
+            assert torch.equal(out_points, points[firsts])
+    out_points, out_features, _ = voxel_downsample(points, None, voxel_size)
+    assert out_features is None
+
+
+def test_sample_mesh_surface():
+    # unit cube, faces oriented outward, and a degenerate face
+    vertices = torch.tensor([
+        [0,0,0], [1,0,0], [1,1,0], [0,1,0],
+        [0,0,1], [1,0,1], [1,1,1], [0,1,1]], dtype=torch.float32)
+    faces = torch.tensor([
+        [0,2,1], [0,3,2], [4,5,6], [4,6,7], [0,1,5], [0,5,4],
+        [2,3,7], [2,7,6], [1,2,6], [1,6,5], [0,4,7], [0,7,3], [0,0,1]])
+    M = 60000
+    points, normals, sampled_faces = sample_mesh_surface(vertices, faces, M, with_normals=True, seed=1)
+    assert points.shape == (M,3) and normals.shape == (M,3)
+    assert sampled_faces.dtype == torch.int64
+    # the degenerate face is never sampled, the others about equally
+    counts = torch.bincount(sampled_faces, minlength=13)
+    assert counts[12] == 0
+    assert ((counts[:12] - M / 12).abs() < 5 * (M / 12)**0.5).all()
+    # points on the faces of the cube, normals outward
+    axis = normals.abs().argmax(1)
+    assert torch.allclose(normals.abs().max(1).values, torch.ones(M))
+    side = (normals.gather(1, axis[:,None]) > 0).float().squeeze(1)
+    assert torch.allclose(points.gather(1, axis[:,None]).squeeze(1), side, atol=1e-6)
+    # deterministic, with int faces too
+    same, none, _ = sample_mesh_surface(vertices, faces.int(), M, seed=1)
+    assert torch.equal(points, same)
+    assert none is None
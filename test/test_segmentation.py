@@ -0,0 +1,39 @@
+import torch
+from torch_points import euclidean_clusters
+
+
+def test_euclidean_clusters():
+    # 3 blobs far from each other and isolated points
+    centers = torch.tensor([[0.,0,0], [10,0,0], [0,10,0]])
+    blobs = centers.repeat_interleave(200, 0) + 0.5 * torch.rand([600,3])
+    isolated = torch.tensor([[20.,20,20], [-20,-20,-20]])
+    points = torch.cat([isolated[:1], blobs, isolated[1:]])
+    labels, offsets, indices = euclidean_clusters(points, 0.5, min_size=2)
+    assert labels.dtype == torch.int32
+    assert labels[0] == -1 and labels[-1] == -1
+    assert (labels[1:201] == 0).all()
+    assert (labels[201:401] == 1).all()
+    assert (labels[401:601] == 2).all()
+    assert offsets.tolist() == [0, 200, 400, 600]
+    assert torch.equal(indices.long(), torch.arange(1, 601))
+
+
+def test_euclidean_clusters_reference():
+    points = 5 * torch.rand([1000,3])
+    d = 0.3
+    labels, offsets, indices = euclidean_clusters(points, d)
+    # same labels for the points at distance at most d
+    i, j = (torch.cdist(points, points) <= d).nonzero().T
+    assert torch.equal(labels[i], labels[j])
+    # components are connected: the graph restricted to a cluster has a single component
+    for k in range(len(offsets) - 1):
+        members = indices[offsets[k]:offsets[k+1]].long()
+        adjacency = torch.cdist(points[members], points[members]) <= d
+        reached = torch.zeros(len(members), dtype=torch.bool)
+        reached[0] = True
+        for _ in range(len(members)):
+            next_reached = (adjacency & reached[None,:]).any(1)
+            if torch.equal(next_reached, reached):
+                break
+            reached = next_reached
+        assert reached.all()
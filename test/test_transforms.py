@@ -0,0 +1,40 @@
+import torch
+from torch_points import transform_points
+
+
+def test_transform_points():
+    points = torch.randn([1000,3])
+    normals = torch.nn.functional.normalize(torch.randn([1000,3]), dim=1)
+    batch = torch.cat([torch.zeros(300), torch.ones(700)]).long()
+    matrices = torch.eye(4).repeat(2,1,1)
+    matrices[:,:3] = torch.randn([2,3,4])
+    out_points, out_normals = transform_points(points, matrices, normals, batch)
+    A, t = matrices[batch,:3,:3], matrices[batch,:3,3]
+    ref = (A @ points.unsqueeze(-1)).squeeze(-1) + t
+    assert torch.allclose(out_points, ref, atol=1e-4)
+    ref_normals = (torch.linalg.inv(A).transpose(1,2) @ normals.unsqueeze(-1)).squeeze(-1)
+    ref_normals = torch.nn.functional.normalize(ref_normals, dim=1)
+    assert torch.allclose(out_normals, ref_normals, atol=1e-4)
+    # a single matrix for all the samples, without normals
+    out_points, out_normals = transform_points(points, matrices[0])
+    assert torch.allclose(out_points, points @ matrices[0,:3,:3].T + matrices[0,:3,3], atol=1e-4)
+    assert out_normals is None
+    # singular matrices are allowed without normals
+    projection = torch.diag(torch.tensor([1., 1., 0., 1.]))
+    out_points, _ = transform_points(points, projection)
+    assert torch.equal(out_points[:,2], torch.zeros(1000))
+
+
+def test_transform_points_jitter():
+    points = torch.zeros([100000,3])
+    jittered, _ = transform_points(points, torch.eye(4), jitter=0.1, seed=3)
+    assert abs(jittered.mean().item()) < 1e-3
+    assert abs(jittered.std().item() - 0.1) < 1e-3
+    same, _ = transform_points(points, torch.eye(4), jitter=0.1, seed=3)
+    assert torch.equal(jittered, same)
+    other, _ = transform_points(points, torch.eye(4), jitter=0.1, seed=4)
+    assert not torch.equal(jittered, other)
+    # in place
+    out, _ = transform_points(points, torch.eye(4), jitter=0.1, seed=3, inplace=True)
+    assert out.data_ptr() == points.data_ptr()
+    assert torch.equal(points, jittered)
@@ -1,5 +1,13 @@
 from .io import read_ply, read_ply_data, write_ply, write_ply_data, read_xyz, read_txt
-from .spatial import build_grid2d
-from .sampling import sample_points_random
+from .spatial import build_grid2d, build_grid2d_batch, build_grid2d_auto, grid2d_reduce, grid2d_rasterize, grid2d_to_patches, knn_graph, radius_graph, ball_query, morton_encode, hilbert_encode, spatial_sort, DynamicGrid2D, Quadtree, Octree, KDTree
+from .features import estimate_normals, covariance_features, three_interpolate
+from .filtering import remove_statistical_outliers, remove_radius_outliers, crop_box, crop_obb, crop_polygon
+from .metrics import chamfer_distance
+from .segmentation import euclidean_clusters
+from .registration import icp, ICP
+from .transforms import transform_points
+from .collate import pad_batch, unpad
+from .pipeline import Pipeline
+from .sampling import sample_points_random, sample_points_fps, sample_points_poisson, voxel_downsample, sample_mesh_surface
 from .dummy import dummy
 
@@ -0,0 +1,65 @@
+from typing import Optional, Sequence, Tuple, Union
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def pad_batch(
+        values: Union[torch.Tensor,Sequence[torch.Tensor]],
+        offsets: Optional[torch.Tensor]=None,
+        Nmax: int=0,
+        mode: str='zero',
+        seed: Optional[int]=None,
+        pin_memory: bool=False) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Pad variable-size samples into a dense batch.
+
+    The batch is written in one parallel pass, without intermediate tensors.
+
+    .. code-block:: python
+
+        def collate(clouds):
+            points, mask = pad_batch([cloud for cloud in clouds], pin_memory=True)
+            return points, mask
+
+    Args:
+        values (Union[torch.Tensor,Sequence[torch.Tensor]]): samples of shape `(N_b,...)`
+            with the same dtype and trailing sizes, or their concatenation of shape `(N,...)`.
+        offsets (torch.Tensor): int offsets of shape `(B+1,)` of the samples in `values`
+            if it is a tensor.
+        Nmax (int): The number of rows of the batch, the size of the largest sample if
+            `Nmax <= 0`. Longer samples are truncated.
+        mode (str): The padding rows are zeros with `'zero'`, the rows of the sample
+            repeated cyclically with `'repeat'`, random rows of the sample with `'random'`.
+            Rows of empty samples are zeros.
+        seed (int): seed of the `'random'` mode, drawn from the default torch generator if None.
+        pin_memory (bool): If True, the batch is allocated in pinned memory.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: `padded` of shape `(B,Nmax,...)` and bool `mask`
+        of shape `(B,Nmax)`, true for the rows of the samples.
+    '''
+    if isinstance(values, torch.Tensor):
+        if offsets is None:
+            raise ValueError('offsets are required with concatenated values')
+        values = values.split(offsets.diff().tolist())
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item()) if mode == 'random' else 0
+    return csrc.pad_batch(list(values), Nmax, mode, seed, pin_memory)
+
+def unpad(
+        padded: torch.Tensor,
+        lengths: torch.Tensor) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Concatenate the samples of a dense batch, inverse of :func:`pad_batch`.
+
+    Args:
+        padded (torch.Tensor): batch of shape `(B,Nmax,...)`.
+        lengths (torch.Tensor): number of rows of each sample of shape `(B,)`, or
+            bool mask of shape `(B,Nmax)` as returned by :func:`pad_batch`.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: `values` of shape `(N,...)` and int `offsets`
+        of shape `(B+1,)`, rows `offsets[b]:offsets[b+1]` are the sample `b`.
+    '''
+    if lengths.dtype == torch.bool:
+        lengths = lengths.sum(1)
+    return csrc.unpad(padded, lengths)
@@ -0,0 +1,95 @@
+from typing import Optional, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def estimate_normals(
+        points: torch.Tensor,
+        k: int=16,
+        r: float=0,
+        viewpoint: Optional[torch.Tensor]=None) -> torch.Tensor:
+    '''
+    Estimate the normals of 3D points by PCA of their neighborhood.
+
+    Neighbors are searched in a uniform 3D grid and the covariance of each
+    neighborhood is decomposed by a closed-form 3x3 eigen solver, in parallel
+    over the points.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        k (int): The number of neighbors (including the point itself), if `r > 0`
+            only the `k` nearest neighbors within `r` are used, all of them if `k <= 0`.
+        r (float): The radius of the neighborhoods, unused if `r <= 0`.
+        viewpoint (torch.Tensor): optional 3D point of shape `(3,)`, normals are
+            flipped toward it.
+
+    Returns:
+        torch.Tensor: unit normals of shape `(N,3)`, zero if the neighborhood has
+        less than 3 points.
+    '''
+    return csrc.estimate_normals(points, k, r, viewpoint)
+
+def covariance_features(
+        points: torch.Tensor,
+        k: int=16,
+        r: float=0) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Compute the eigenvalues of the covariance of the neighborhood of 3D points
+    and the derived shape features.
+
+    Neighborhoods are the same as in :func:`estimate_normals`.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        k (int): The number of neighbors (including the point itself), if `r > 0`
+            only the `k` nearest neighbors within `r` are used, all of them if `k <= 0`.
+        r (float): The radius of the neighborhoods, unused if `r <= 0`.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: eigenvalues `l0 <= l1 <= l2` of shape `(N,3)`
+        and features of shape `(N,4)`: linearity `(l2-l1)/l2`, planarity `(l1-l0)/l2`,
+        scattering `l0/l2` and curvature `l0/(l0+l1+l2)`, zero if `l2` is zero.
+    '''
+    return csrc.covariance_features(points, k, r)
+
+class ThreeInterpolate(torch.autograd.Function):
+    '''
+    Autograd function of :func:`three_interpolate`, differentiable with respect
+    to the coarse features.
+    '''
+    @staticmethod
+    def forward(ctx, dense_points, coarse_points, coarse_features):
+        features, indices, weights = csrc.three_interpolate(dense_points, coarse_points, coarse_features)
+        ctx.save_for_backward(indices, weights)
+        ctx.M = coarse_features.size(-2)
+        return features
+
+    @staticmethod
+    def backward(ctx, grad_features):
+        indices, weights = ctx.saved_tensors
+        grad_coarse = csrc.three_interpolate_backward(indices, weights, grad_features.contiguous(), ctx.M)
+        return None, None, grad_coarse
+
+def three_interpolate(
+        dense_points: torch.Tensor,
+        coarse_points: torch.Tensor,
+        coarse_features: torch.Tensor) -> torch.Tensor:
+    '''
+    Interpolate features from coarse points to dense points, as in the feature
+    propagation layers of PointNet++.
+
+    The features of each dense point are the average of the features of its 3
+    nearest coarse points weighted by their inverse squared distance. Neighbors
+    are searched in a uniform 3D grid and the features are accumulated in the
+    same pass, in parallel over the dense points, so no `(N,M)` intermediate is
+    built. The result is differentiable with respect to `coarse_features`.
+
+    Args:
+        dense_points (torch.Tensor): 3D points of shape `(N,3)` or `(B,N,3)`.
+        coarse_points (torch.Tensor): 3D points of shape `(M,3)` or `(B,M,3)`.
+        coarse_features (torch.Tensor): float features of shape `(M,C)` or `(B,M,C)`.
+
+    Returns:
+        torch.Tensor: features of shape `(N,C)` or `(B,N,C)`, if a sample has less
+        than 3 coarse points all of them are used, zero if it has none.
+    '''
+    return ThreeInterpolate.apply(dense_points, coarse_points, coarse_features)
@@ -0,0 +1,111 @@
+from typing import Optional, Sequence, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def remove_statistical_outliers(
+        points: torch.Tensor,
+        k: int=16,
+        std_ratio: float=2) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Remove the points far from their neighbors compared to the other points.
+
+    A point is removed if the mean distance to its `k` nearest neighbors is
+    larger than `mean + std_ratio * std` of this mean distance over all the
+    points. Neighbors are searched in a uniform 3D grid in parallel over the
+    points.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        k (int): The number of neighbors.
+        std_ratio (float): The number of standard deviations of the threshold.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: bool mask of the kept points of shape `(N,)`
+        and long indices of the kept points of shape `(M,)`.
+    '''
+    return csrc.remove_statistical_outliers(points, k, std_ratio)
+
+def remove_radius_outliers(
+        points: torch.Tensor,
+        r: float,
+        min_neighbors: int) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Remove the points with less than `min_neighbors` other points within distance `r`.
+
+    The neighbor search of a point stops as soon as enough neighbors are found.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        r (float): The radius.
+        min_neighbors (int): The minimal number of neighbors of the kept points.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: bool mask of the kept points of shape `(N,)`
+        and long indices of the kept points of shape `(M,)`.
+    '''
+    return csrc.remove_radius_outliers(points, r, min_neighbors)
+
+def crop_box(
+        points: torch.Tensor,
+        bounds: Sequence[float]) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Crop 3D points to an axis-aligned box.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        bounds (Sequence[float]): `xmin/xmax/ymin/ymax/zmin/zmax` of the box, included.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: bool mask of the points inside of shape `(N,)`
+        and long indices of the points inside of shape `(M,)`.
+    '''
+    return csrc.crop_box(points, torch.as_tensor(bounds, dtype=torch.float32))
+
+def crop_obb(
+        points: torch.Tensor,
+        center: Sequence[float],
+        rotation: torch.Tensor,
+        extent: Sequence[float]) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Crop 3D points to an oriented box.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        center (Sequence[float]): The center of the box.
+        rotation (torch.Tensor): rotation of shape `(3,3)` whose columns are the axes of the box.
+        extent (Sequence[float]): The sizes of the box along its axes.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: bool mask of the points inside of shape `(N,)`
+        and long indices of the points inside of shape `(M,)`.
+    '''
+    return csrc.crop_obb(
+        points, 
+        torch.as_tensor(center, dtype=torch.float32), 
+        torch.as_tensor(rotation, dtype=torch.float32), 
+        torch.as_tensor(extent, dtype=torch.float32))
+
+def crop_polygon(
+        points: torch.Tensor,
+        polygon: torch.Tensor,
+        rings: Optional[torch.Tensor]=None) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Crop 3D points to a 2D polygon in x/y.
+
+    The bounding box of the polygon is split in cells with the arithmetic of
+    :func:`build_grid2d` and the edges are bucketed by row of cells. Cells not
+    crossed by an edge are classified once as inside or outside, only the points
+    in the other cells are tested by ray casting against the edges of their row.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        polygon (torch.Tensor): float vertices of shape `(P,2)`, rings are closed implicitly.
+        rings (torch.Tensor): optional int offsets of shape `(R+1,)`, vertices
+            `rings[r]:rings[r+1]` are the ring `r`, one ring by default. The inside
+            is given by the even-odd rule, so holes are rings inside the outer ring.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: bool mask of the points inside of shape `(N,)`
+        and long indices of the points inside of shape `(M,)`.
+    '''
+    return csrc.crop_polygon(points, polygon.float().contiguous(), rings)
@@ -0,0 +1,53 @@
+from typing import Optional, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+class ChamferDistance(torch.autograd.Function):
+    '''
+    Autograd function of :func:`chamfer_distance`, differentiable with respect
+    to the points through the distances.
+    '''
+    @staticmethod
+    def forward(ctx, a, b, a_offsets, b_offsets):
+        dist_a, idx_a, dist_b, idx_b = csrc.chamfer_distance(a, b, a_offsets, b_offsets)
+        ctx.save_for_backward(a, b, idx_a, idx_b)
+        ctx.mark_non_differentiable(idx_a, idx_b)
+        return dist_a, idx_a, dist_b, idx_b
+
+    @staticmethod
+    def backward(ctx, grad_dist_a, grad_idx_a, grad_dist_b, grad_idx_b):
+        a, b, idx_a, idx_b = ctx.saved_tensors
+        grad_a, grad_b = csrc.chamfer_distance_backward(
+            a, b, idx_a, idx_b, grad_dist_a.contiguous(), grad_dist_b.contiguous())
+        return grad_a, grad_b, None, None
+
+def chamfer_distance(
+        a: torch.Tensor,
+        b: torch.Tensor,
+        a_offsets: Optional[torch.Tensor]=None,
+        b_offsets: Optional[torch.Tensor]=None) -> Tuple[torch.Tensor,torch.Tensor,torch.Tensor,torch.Tensor]:
+    '''
+    Find the nearest neighbors between two batches of point clouds.
+
+    Neighbors are searched in a uniform 3D grid built for each sample, in
+    parallel over the points, so no distance matrix is built. The distances
+    are differentiable with respect to `a` and `b`, the backward pass does not
+    build a distance matrix either.
+
+    The Chamfer distance of a single sample is `dist_a.mean() + dist_b.mean()`.
+
+    Args:
+        a (torch.Tensor): 3D points of shape `(N,3)`.
+        b (torch.Tensor): 3D points of shape `(M,3)`.
+        a_offsets (torch.Tensor): optional int offsets of shape `(B+1,)`, points
+            `a_offsets[s]:a_offsets[s+1]` are the sample `s` of `a`.
+        b_offsets (torch.Tensor): optional int offsets of shape `(B+1,)` of `b`.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor,torch.Tensor,torch.Tensor]: squared distance
+        from each point of `a` to the nearest point of `b` in the same sample of
+        shape `(N,)`, its int index in `b` of shape `(N,)`, and the same from `b`
+        to `a` of shape `(M,)`. Distances are `inf` and indices `-1` if the other
+        sample is empty.
+    '''
+    return ChamferDistance.apply(a, b, a_offsets, b_offsets)
@@ -0,0 +1,149 @@
+from typing import List, Optional, Sequence, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+class Pipeline:
+    '''
+    Lazy preprocessing pipeline of 3D points.
+
+    The builder methods record the stages, which have the semantics of the
+    functions of the same name, and return the pipeline so that they can be
+    chained. Nothing is computed until the pipeline is called on points or on
+    a PLY file.
+
+    Consecutive streaming stages (:meth:`crop_box`, :meth:`crop_obb`,
+    :meth:`crop_polygon` and :meth:`transform`) are fused: the points go
+    through all of them chunk by chunk and are compacted into the single
+    output buffer of the pass, so no intermediate cloud is allocated between
+    them. With :meth:`read_ply`, the chunks of the first pass are filled
+    directly by the PLY body decoder and only the kept coordinates are
+    stored. The other stages need the whole cloud and run between the fused
+    passes; :meth:`normalize` computes its centroid and scale on the whole
+    cloud and is then fused as an affine transform with the next streaming
+    stages.
+
+    .. code-block:: python
+
+        pipeline = (Pipeline()
+            .crop_box([0, 100, 0, 100, -5, 50])
+            .voxel_downsample(0.05)
+            .remove_statistical_outliers(16, 2)
+            .normalize()
+            .grid2d(cell_size=0.02))
+        points, cells, indices, bounds = pipeline.read_ply('cloud.ply')
+        for stage, seconds in pipeline.timings:
+            print(f'{stage}: {1000 * seconds:.1f} ms')
+
+    Args:
+        chunk_size (int): The number of points of the chunks of the fused passes.
+    '''
+    def __init__(self, chunk_size: int=16384):
+        self._pipeline = csrc.Pipeline(chunk_size)
+
+    def crop_box(self, bounds: Sequence[float]) -> 'Pipeline':
+        '''
+        Crop the points to an axis-aligned box, see :func:`crop_box`.
+        '''
+        self._pipeline.crop_box(torch.as_tensor(bounds, dtype=torch.float32))
+        return self
+
+    def crop_obb(
+            self,
+            center: Sequence[float],
+            rotation: torch.Tensor,
+            extent: Sequence[float]) -> 'Pipeline':
+        '''
+        Crop the points to an oriented box, see :func:`crop_obb`.
+        '''
+        self._pipeline.crop_obb(
+            torch.as_tensor(center, dtype=torch.float32),
+            torch.as_tensor(rotation, dtype=torch.float32),
+            torch.as_tensor(extent, dtype=torch.float32))
+        return self
+
+    def crop_polygon(self, polygon: torch.Tensor, rings: Optional[torch.Tensor]=None) -> 'Pipeline':
+        '''
+        Crop the points to a 2D polygon in x/y, see :func:`crop_polygon`.
+        '''
+        self._pipeline.crop_polygon(polygon.float().contiguous(), rings)
+        return self
+
+    def transform(self, matrix: torch.Tensor) -> 'Pipeline':
+        '''
+        Apply an affine transform of shape `(4,4)` to the points, the last row is ignored.
+        '''
+        self._pipeline.transform(torch.as_tensor(matrix, dtype=torch.float32))
+        return self
+
+    def voxel_downsample(self, voxel_size: float, mode: str='mean') -> 'Pipeline':
+        '''
+        Downsample the points to one point per occupied voxel, see :func:`voxel_downsample`.
+        '''
+        self._pipeline.voxel_downsample(voxel_size, mode)
+        return self
+
+    def remove_statistical_outliers(self, k: int=16, std_ratio: float=2) -> 'Pipeline':
+        '''
+        Remove the points far from their neighbors, see :func:`remove_statistical_outliers`.
+        '''
+        self._pipeline.remove_statistical_outliers(k, std_ratio)
+        return self
+
+    def remove_radius_outliers(self, r: float, min_neighbors: int) -> 'Pipeline':
+        '''
+        Remove the points with few neighbors, see :func:`remove_radius_outliers`.
+        '''
+        self._pipeline.remove_radius_outliers(r, min_neighbors)
+        return self
+
+    def normalize(self, scale: bool=True) -> 'Pipeline':
+        '''
+        Center the points on their centroid and, if `scale` is True, scale them
+        into the unit sphere.
+        '''
+        self._pipeline.normalize(scale)
+        return self
+
+    def grid2d(self, cell_size: float=0, points_per_cell: float=0, sort_z: bool=False) -> 'Pipeline':
+        '''
+        Build a 2D grid of the points, see :func:`build_grid2d_auto`. This must be the last stage.
+        '''
+        self._pipeline.grid2d(cell_size, points_per_cell, sort_z)
+        return self
+
+    def __call__(self, points: torch.Tensor) -> Tuple[torch.Tensor,Optional[torch.Tensor],Optional[torch.Tensor],Optional[torch.Tensor]]:
+        '''
+        Run the pipeline on points.
+
+        Args:
+            points (torch.Tensor): 3D points of shape `(N,3)`, not modified.
+
+        Returns:
+            tuple:
+                A tuple containing:
+
+                - `points` of shape `(M,3)` at the end of the pipeline.
+                - `cells` of shape `(Nx,Ny,2)` of the :meth:`grid2d` stage, None without it.
+                - `indices` of shape `(M,)` of the :meth:`grid2d` stage, None without it.
+                - `bounds` of shape `(4,)` of the :meth:`grid2d` stage, None without it.
+        '''
+        return self._pipeline.run(points)
+
+    def read_ply(self, path: str) -> Optional[Tuple[torch.Tensor,Optional[torch.Tensor],Optional[torch.Tensor],Optional[torch.Tensor]]]:
+        '''
+        Run the pipeline on the `x`, `y` and `z` vertex properties of a PLY file.
+
+        Returns:
+            The tuple returned by calling the pipeline, None if the file can not be read.
+        '''
+        return self._pipeline.run_ply(path)
+
+    @property
+    def timings(self) -> List[Tuple[str,float]]:
+        '''
+        The seconds spent in each stage during the last run, in the order of
+        the stages, after a `'read_ply'` entry for the PLY decoding. The times
+        of the fused stages are summed over the chunks, so over the threads
+        when the chunks are processed in parallel.
+        '''
+        return self._pipeline.timings()
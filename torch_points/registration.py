@@ -0,0 +1,89 @@
+import math
+from typing import Optional, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def icp(
+        source: torch.Tensor,
+        target: torch.Tensor,
+        max_iters: int=30,
+        max_dist: float=math.inf,
+        mode: str='point_to_point',
+        target_normals: Optional[torch.Tensor]=None,
+        init: Optional[torch.Tensor]=None,
+        tolerance: float=1e-6) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Align source points onto target points by iterative closest point.
+
+    At each iteration the nearest target point of each transformed source point
+    is searched in a uniform 3D grid built once, in parallel over the source
+    points. Correspondences farther than `max_dist` are rejected and the
+    transform is updated by solving the 6x6 normal equations of the linearized
+    residuals.
+
+    To align several sources onto the same target, use :class:`ICP`.
+
+    Args:
+        source (torch.Tensor): 3D points of shape `(N,3)`.
+        target (torch.Tensor): 3D points of shape `(M,3)`.
+        max_iters (int): The maximum number of iterations.
+        max_dist (float): The maximum distance of the correspondences.
+        mode (str): `'point_to_point'` to minimize the distances between the
+            correspondences, `'point_to_plane'` to minimize their distances along
+            the target normals.
+        target_normals (torch.Tensor): optional normals of the target of shape `(M,3)`,
+            estimated from 16 neighbors if needed and not given.
+        init (torch.Tensor): optional initial transform of shape `(4,4)`.
+        tolerance (float): Iterations stop when the norm of the update (rotation
+            vector and translation) is smaller.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: `transform` of shape `(4,4)` mapping the
+        source onto the target and `residuals` of shape `(I,)`, the RMS residual of
+        the correspondences at each iteration.
+    '''
+    return csrc.icp(source, target, max_iters, max_dist, mode, target_normals, init, tolerance)
+
+class ICP:
+    '''
+    Iterative closest point registration onto a fixed target, see :func:`icp`.
+
+    The target is indexed once and its normals are estimated at most once, so
+    successive sources are aligned without rebuilding them.
+
+    .. code-block:: python
+
+        registration = ICP(target)
+        transform, residuals = registration.align(source, mode='point_to_plane')
+
+    Args:
+        target (torch.Tensor): 3D points of shape `(M,3)`.
+        target_normals (torch.Tensor): optional normals of the target of shape `(M,3)`.
+    '''
+    def __init__(self, target: torch.Tensor, target_normals: Optional[torch.Tensor]=None):
+        self._icp = csrc.ICP(target, target_normals)
+
+    def align(
+            self,
+            source: torch.Tensor,
+            max_iters: int=30,
+            max_dist: float=math.inf,
+            mode: str='point_to_point',
+            init: Optional[torch.Tensor]=None,
+            tolerance: float=1e-6) -> Tuple[torch.Tensor,torch.Tensor]:
+        '''
+        Align source points onto the target.
+
+        Args:
+            source (torch.Tensor): 3D points of shape `(N,3)`.
+            max_iters (int): The maximum number of iterations.
+            max_dist (float): The maximum distance of the correspondences.
+            mode (str): `'point_to_point'` or `'point_to_plane'`.
+            init (torch.Tensor): optional initial transform of shape `(4,4)`.
+            tolerance (float): Iterations stop when the norm of the update is smaller.
+
+        Returns:
+            Tuple[torch.Tensor,torch.Tensor]: `transform` of shape `(4,4)` and
+            `residuals` of shape `(I,)`.
+        '''
+        return self._icp.align(source, max_iters, max_dist, mode, init, tolerance)
@@ -1,18 +1,180 @@
+from typing import Optional, Sequence, Tuple, Union
 import torch
+import torch_points.torch_points_csrc as csrc
 
 def sample_points_random(
         points: torch.Tensor, 
-        M: int):
+        M: Union[int,torch.Tensor],
+        offsets: Optional[torch.Tensor]=None,
+        seed: Optional[int]=None,
+        attributes: Sequence[torch.Tensor]=(),
+        return_indices: bool=False):
     """
     Randomly sample `M` 3D points.
 
+    The indices are drawn without any allocation of size `N`: Floyd's algorithm
+    is used when `M` is small compared to `N`, otherwise a sequential selection
+    in a single pass. Samples of a batch are processed in parallel, each with
+    its own generator seeded from `seed`. On other devices than the CPU, the
+    indices are drawn by :func:`torch.randperm` on the device of the points.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        M (int or torch.Tensor): number of samples, or number of samples in each
+            sample of the batch of shape `(B,)`.
+        offsets (torch.Tensor): optional int offsets of shape `(B+1,)`, points
+            `offsets[b]:offsets[b+1]` are the sample `b`.
+        seed (int): seed of the sampling, drawn from the default torch generator
+            if None.
+        attributes (Sequence[torch.Tensor]): tensors of shape `(N,...)` gathered
+            with the points.
+        return_indices (bool): If True, the indices of the sampled points are also
+            returned.
+
+    Returns:
+        torch.Tensor: sampled 3D points of shape `(M,3)`, in random order in each
+        sample of the batch, followed by the sampled attributes of shape `(M,...)`
+        and the long indices of shape `(M,)` if `return_indices` is True.
+    """
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item())
+    counts = torch.as_tensor(M, dtype=torch.int32).reshape(-1)
+    if points.device.type == 'cpu':
+        indices, samples, attributes = csrc.sample_points_random(
+            points.contiguous(), offsets, counts, seed, [a.contiguous() for a in attributes])
+    else:
+        generator = torch.Generator(device=points.device)
+        generator.manual_seed(seed)
+        bounds = [0, points.shape[0]] if offsets is None else offsets.tolist()
+        B = len(bounds) - 1
+        if counts.numel() not in (1, B):
+            raise ValueError('M must have size [1] or [B]')
+        permutations = []
+        for b, m in enumerate(counts.expand(B).tolist()):
+            n = bounds[b+1] - bounds[b]
+            if not 0 <= m <= n:
+                raise ValueError(f'invalid number of points {m} in sample {b}')
+            permutations.append(bounds[b] + torch.randperm(n, device=points.device, generator=generator)[:m])
+        indices = torch.cat(permutations) if permutations else torch.zeros([0], dtype=torch.long, device=points.device)
+        samples = points[indices]
+        attributes = [a[indices] for a in attributes]
+    result = (samples, *attributes) + ((indices,) if return_indices else ())
+    return result[0] if len(result) == 1 else result
+
+def sample_points_fps(
+        points: torch.Tensor,
+        M: int,
+        start_idx: int=0,
+        offsets: Optional[torch.Tensor]=None,
+        approximate: bool=False) -> Tuple[torch.Tensor,torch.Tensor]:
+    """
+    Sample `M` 3D points by farthest point sampling.
+
+    Each new sample is the point farthest from the previous ones. The distances
+    are updated in parallel over the points, or over the samples of a batch
+    when there are enough of them.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        M (int): number of samples (per sample of the batch)
+        start_idx (int): index of the first sample in each sample of the batch
+        offsets (torch.Tensor): optional int offsets of shape `(B+1,)`, points
+            `offsets[b]:offsets[b+1]` are the sample `b`.
+        approximate (bool): If True, only one point per cell of a uniform grid
+            with about `4*M` non-empty cells is considered, which is much faster
+            for large point clouds.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: sampled 3D points of shape `(B*M,3)` and
+        their indices in `points` of shape `(B*M,)`, the `M` first ones are in
+        the sample 0, the next `M` ones in the sample 1, etc.
+    """
+    indices = csrc.sample_points_fps(points, offsets, M, start_idx, approximate)
+    return points[indices.long()], indices
+
+def sample_points_poisson(
+        points: torch.Tensor,
+        r: float,
+        seed: Optional[int]=None) -> Tuple[torch.Tensor,torch.Tensor]:
+    """
+    Sample 3D points at least `r` apart (Poisson-disk sampling).
+
+    Points are tried in a random order in a uniform grid with cells of size at
+    least `r`, each one is kept if no kept point of the neighboring cells is
+    closer than `r`. Cells are processed in parallel in 8 phases by parity of
+    their coordinates so that the result only depends on `seed`.
+    Every point that is not kept is closer than `r` to a kept point.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        r (float): minimal distance between the samples.
+        seed (int): seed of the sampling, drawn from the default torch generator
+            if None.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: sampled 3D points of shape `(S,3)` and
+        their sorted indices in `points` of shape `(S,)`.
+    """
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item())
+    indices = csrc.sample_points_poisson(points, r, seed)
+    return points[indices.long()], indices
+
+def voxel_downsample(
+        points: torch.Tensor,
+        features: Optional[torch.Tensor],
+        voxel_size: float,
+        mode: str='mean') -> Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor]:
+    """
+    Downsample 3D points to one point per occupied voxel.
+
+    The occupied voxels are found in one parallel pass with a concurrent hash
+    table, then the points are grouped by voxel with a counting sort and each
+    voxel is reduced in the order of its points, so the results do not depend
+    on the number of threads. Voxels are numbered in the order of their first
+    point.
+
     Args:
         points (torch.Tensor): 3D points of shape `(N,3)`.
-        M (int): number of samples
+        features (torch.Tensor): optional float features of shape `(N,C)`, or None.
+        voxel_size (float): side of the voxels.
+        mode (str): `'mean'` for the centroid of the voxel, `'first'` for the first
+            point of the voxel, `'nearest'` for the point nearest to the centroid.
+
+    Returns:
+        Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor]: 3D points of shape `(V,3)`,
+        mean features of each voxel of shape `(V,C)` (None without features) and
+        the voxel of each input point of shape `(N,)`.
+    """
+    return csrc.voxel_downsample(points, features, voxel_size, mode)
+
+def sample_mesh_surface(
+        vertices: torch.Tensor,
+        faces: torch.Tensor,
+        M: int,
+        with_normals: bool=False,
+        seed: Optional[int]=None) -> Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor]:
+    """
+    Sample points uniformly on the surface of a triangle mesh.
+
+    Faces are drawn with probability proportional to their area by a binary
+    search in their cumulative areas, then each point is placed in its face by
+    uniform barycentric coordinates, in parallel over the points. Each point only
+    depends on the seed and its index, not on the number of threads.
+
+    Args:
+        vertices (torch.Tensor): 3D vertices of shape `(V,3)`.
+        faces (torch.Tensor): int or long vertex indices of the triangles of shape `(F,3)`.
+        M (int): The number of points.
+        with_normals (bool): If True, the normals of the faces of the points are returned.
+        seed (int): seed of the sampling, drawn from the default torch generator
+            if None.
 
     Returns:
-        torch.Tensor: sampled 3D points of shape `(M,3)`.
+        Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor]: sampled 3D points of shape
+        `(M,3)`, unit normals of their faces of shape `(M,3)` oriented by the order of the
+        vertices (None if `with_normals` is False), and long face of each point of shape `(M,)`.
     """
-    N = len(points)
-    assert 1 <= M and M <= N
-    return points[torch.randperm(N, dtype=torch.int32, device=points.device)[:M]]
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item())
+    return csrc.sample_mesh_surface(vertices, faces, M, with_normals, seed)
@@ -0,0 +1,36 @@
+from typing import Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def euclidean_clusters(
+        points: torch.Tensor,
+        d: float,
+        min_size: int=1) -> Tuple[torch.Tensor,torch.Tensor,torch.Tensor]:
+    '''
+    Extract the clusters of 3D points connected by chains of points at distance
+    at most `d`.
+
+    Points are binned in a uniform 3D grid of cell size at least `d` and the
+    pairs of neighboring points are linked in parallel by a lock-free union-find,
+    so no neighbors graph is built.
+
+    To access the points of a cluster `k`:
+
+    .. code-block:: python
+
+        labels, offsets, indices = euclidean_clusters(points, d)
+        cluster = points[indices[offsets[k]:offsets[k+1]].long()]
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        d (float): The distance tolerance.
+        min_size (int): The minimum number of points of a cluster.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor,torch.Tensor]: int `labels` of shape `(N,)`,
+        the cluster of each point, `-1` for the points of the components smaller than
+        `min_size`, clusters being ordered by their smallest point index. int `offsets`
+        of shape `(K+1,)` and int `indices` of the points of each cluster in increasing
+        order.
+    '''
+    return csrc.euclidean_clusters(points, d, min_size)
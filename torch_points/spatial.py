@@ -1,4 +1,4 @@
-from typing import Tuple
+from typing import Optional, Sequence, Tuple
 import torch
 import torch_points.torch_points_csrc as csrc
 
@@ -43,3 +43,636 @@ def build_grid2d(
             - `indices` of shape `(N,)` refering to the original points.
     '''
     return csrc.build_grid2d(points, xmin, xmax, ymin, ymax, Nx, Ny, sort_z)
+
+def build_grid2d_batch(
+        points: torch.Tensor,
+        offsets: torch.Tensor,
+        bounds: torch.Tensor,
+        Nx: int,
+        Ny: int,
+        sort_z: bool=False) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Build a 2D grid for each sample of a batch of concatenated point clouds.
+
+    All the grids are built in a single parallel pass, balanced over the points
+    and the cells of all samples. The cells of each sample follow the same
+    semantics as :func:`build_grid2d`.
+
+    To access the points in a cell `(i,j)` of the sample `b`:
+
+    .. code-block:: python
+
+        cells, indices = build_grid2d_batch(points, offsets, bounds, Nx, Ny)
+        begin = cells[b,i,j,0].item()
+        end = cells[b,i,j,1].item()
+        points_in_cell = points[indices[begin:end]]
+
+    Args:
+        points (torch.Tensor): concatenated 3D points of shape `(N,3)`.
+        offsets (torch.Tensor): int offsets of shape `(B+1,)`, the sample `b` is `points[offsets[b]:offsets[b+1]]`.
+        bounds (torch.Tensor): bounds of shape `(B,4)` containing `xmin`, `xmax`, `ymin` and `ymax` of each sample.
+        Nx (int): The number of cells in the x direction.
+        Ny (int): The number of cells in the y direction.
+        sort_z (bool): If True, the points are sorted by their z coordinate in each cell.
+
+    Returns:
+        tuple:
+            A tuple containing:
+
+            - `cells` of shape `(B,Nx,Ny,2)` containing the begin/end of points indices in each cell.
+            - `indices` of shape `(N,)` refering to the original points.
+    '''
+    return csrc.build_grid2d_batch(points, offsets, bounds, Nx, Ny, sort_z)
+
+
+def build_grid2d_auto(
+        points: torch.Tensor,
+        cell_size: float=0,
+        points_per_cell: float=0,
+        sort_z: bool=False) -> Tuple[torch.Tensor,torch.Tensor,torch.Tensor]:
+    '''
+    Build a 2D grid whose bounds are computed from the points.
+
+    The grid starts at the minimum x and y of the points and has square cells,
+    either of size `cell_size` or sized to contain `points_per_cell` points on
+    average. `Nx` and `Ny` are chosen so that every point is strictly below
+    `xmax` and `ymax`, hence no point is dropped. Exactly one of `cell_size`
+    and `points_per_cell` must be positive.
+
+    .. code-block:: python
+
+        cells, indices, bounds = build_grid2d_auto(points, cell_size=0.5)
+        Nx, Ny = cells.shape[0], cells.shape[1]
+        xmin, xmax, ymin, ymax = bounds.tolist()
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        cell_size (float): The size of the cells.
+        points_per_cell (float): The average number of points per cell.
+        sort_z (bool): If True, the points are sorted by their z coordinate in each cell.
+
+    Returns:
+        tuple:
+            A tuple containing:
+
+            - `cells` of shape `(Nx,Ny,2)` containing the begin/end of points indices in each cell.
+            - `indices` of shape `(N,)` refering to the original points.
+            - `bounds` of shape `(4,)` containing `xmin`, `xmax`, `ymin` and `ymax`.
+    '''
+    return csrc.build_grid2d_auto(points, cell_size, points_per_cell, sort_z)
+
+
+def grid2d_reduce(
+        points: torch.Tensor,
+        cells: torch.Tensor,
+        indices: torch.Tensor,
+        ops: Sequence[str]=('count', 'mean'),
+        values: Optional[torch.Tensor]=None) -> Tuple[torch.Tensor,...]:
+    '''
+    Compute statistics of the values in each cell of a 2D grid.
+
+    All the reductions are computed in a single pass over the indices of each
+    cell, cells are reduced in parallel.
+
+    Available reductions:
+        - `'count'`: number of points (int)
+        - `'min'`, `'max'`, `'mean'`, `'std'`: statistics of the values, `nan` in empty cells
+        - `'argmin'`, `'argmax'`: index in `points` of the min/max value, `-1` in empty cells (int)
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        cells (torch.Tensor): begin/end indices of shape `(Nx,Ny,2)` as returned by :func:`build_grid2d`.
+        indices (torch.Tensor): indices in points of shape `(N,)` as returned by :func:`build_grid2d`.
+        ops (Sequence[str]): The reductions to compute.
+        values (torch.Tensor): optional float values of shape `(N,)`, z coordinates by default.
+
+    Returns:
+        Tuple[torch.Tensor,...]: one image of shape `(Nx,Ny)` per reduction.
+    '''
+    return tuple(csrc.grid2d_reduce(points, values, cells, indices, list(ops)))
+
+def grid2d_rasterize(
+        points: torch.Tensor,
+        xmin: float,
+        xmax: float,
+        ymin: float,
+        ymax: float,
+        Nx: int,
+        Ny: int,
+        ops: Sequence[str]=('count', 'mean'),
+        values: Optional[torch.Tensor]=None) -> Tuple[torch.Tensor,...]:
+    '''
+    Same as :func:`grid2d_reduce` with the cells of :func:`build_grid2d` computed
+    on the fly.
+
+    When there are several points per cell, each thread reduces a chunk of points
+    into its own images, which are merged at the end, without sorting the points.
+    Otherwise the points are binned by cell with a counting sort, so the scratch
+    memory stays proportional to the number of points and cells. Points outside
+    of the bounds are ignored.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        xmin (float): The minimal x value.
+        xmax (float): The maximal x value.
+        ymin (float): The minimal y value.
+        ymax (float): The maximal y value.
+        Nx (int): The number of cells along the x axis.
+        Ny (int): The number of cells along the y axis.
+        ops (Sequence[str]): The reductions to compute.
+        values (torch.Tensor): optional float values of shape `(N,)`, z coordinates by default.
+
+    Returns:
+        Tuple[torch.Tensor,...]: one image of shape `(Nx,Ny)` per reduction.
+    '''
+    return tuple(csrc.grid2d_rasterize(points, values, xmin, xmax, ymin, ymax, Nx, Ny, list(ops)))
+
+def grid2d_to_patches(
+        points: torch.Tensor,
+        features: Optional[torch.Tensor],
+        cells: torch.Tensor,
+        indices: torch.Tensor,
+        K: int,
+        min_points: int=1,
+        bounds: Optional[Sequence[float]]=None,
+        seed: Optional[int]=None) -> Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor,torch.Tensor,torch.Tensor]:
+    '''
+    Turn each cell of a 2D grid into a patch of `K` points.
+
+    Cells with more than `K` points are randomly subsampled without replacement,
+    the points of cells with less than `K` points are repeated. The patches are
+    written in one parallel pass over the cells.
+
+    .. code-block:: python
+
+        cells, indices = build_grid2d(points, xmin, xmax, ymin, ymax, Nx, Ny)
+        patches, patch_features, _, patch_cells, mask = grid2d_to_patches(
+            points, features, cells, indices, K=256, min_points=16,
+            bounds=(xmin, xmax, ymin, ymax))
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        features (torch.Tensor): optional features of shape `(N,...)` of any dtype, or None.
+        cells (torch.Tensor): begin/end indices of shape `(Nx,Ny,2)` as returned by :func:`build_grid2d`.
+        indices (torch.Tensor): indices in points of shape `(N,)` as returned by :func:`build_grid2d`.
+        K (int): The number of points of each patch.
+        min_points (int): Cells with less points do not give a patch.
+        bounds (Sequence[float]): optional `xmin/xmax/ymin/ymax` of the grid, the x/y
+            coordinates of the patches are then relative to the center of their cell.
+        seed (int): seed of the subsampling, drawn from the default torch generator if None.
+            The points of a cell only depend on the seed and the cell.
+
+    Returns:
+        Tuple[torch.Tensor,Optional[torch.Tensor],torch.Tensor,torch.Tensor,torch.Tensor]:
+        for the `P` cells with at least `min_points` points, in the order of the cells:
+        points of shape `(P,K,3)`, features of shape `(P,K,...)` (None without features),
+        int indices in `points` of shape `(P,K)`, int cell `(i,j)` of each patch of
+        shape `(P,2)` and bool mask of shape `(P,K)`, false for the repeated points.
+    '''
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item())
+    if bounds is not None:
+        bounds = torch.as_tensor(bounds, dtype=torch.float32)
+    return csrc.grid2d_to_patches(points, features, cells, indices, K, min_points, bounds, seed)
+
+
+def knn_graph(
+        points: torch.Tensor,
+        k: int,
+        batch: Optional[torch.Tensor]=None,
+        loop: bool=False,
+        symmetric: bool=False) -> torch.Tensor:
+    '''
+    Build the k nearest neighbors graph of a batch of point clouds.
+
+    Neighbors are searched in a uniform 3D grid built for each sample, in
+    parallel over the samples and the points. Edges are counted first so that
+    the output is allocated with its exact size.
+
+    Args:
+        points (torch.Tensor): concatenated 3D points of shape `(N,3)`.
+        k (int): The number of neighbors of each point.
+        batch (torch.Tensor): optional sorted sample index of each point of shape `(N,)`.
+        loop (bool): If True, each point is its own neighbor.
+        symmetric (bool): If True, the reversed edges are added, without duplicates.
+
+    Returns:
+        torch.Tensor: `edge_index` of shape `(2,E)` where `edge_index[0]` are the neighbors
+        (sources) and `edge_index[1]` the query points (targets), grouped by target.
+    '''
+    return csrc.knn_graph(points, batch, k, loop, symmetric)
+
+def radius_graph(
+        points: torch.Tensor,
+        r: float,
+        batch: Optional[torch.Tensor]=None,
+        max_neighbors: int=32,
+        loop: bool=False,
+        symmetric: bool=False) -> torch.Tensor:
+    '''
+    Build the graph of the points within distance `r` in a batch of point clouds.
+
+    Same as :func:`knn_graph`, only the `max_neighbors` nearest neighbors of each
+    point are kept, unless `max_neighbors <= 0`.
+
+    Args:
+        points (torch.Tensor): concatenated 3D points of shape `(N,3)`.
+        r (float): The radius.
+        batch (torch.Tensor): optional sorted sample index of each point of shape `(N,)`.
+        max_neighbors (int): The maximum number of neighbors of each point.
+        loop (bool): If True, each point is its own neighbor.
+        symmetric (bool): If True, the reversed edges are added, without duplicates.
+
+    Returns:
+        torch.Tensor: `edge_index` of shape `(2,E)` where `edge_index[0]` are the neighbors
+        (sources) and `edge_index[1]` the query points (targets), grouped by target.
+    '''
+    return csrc.radius_graph(points, batch, r, max_neighbors, loop, symmetric)
+
+def ball_query(
+        points: torch.Tensor,
+        centroids: torch.Tensor,
+        r: float,
+        K: int) -> Tuple[torch.Tensor,torch.Tensor]:
+    '''
+    Find the neighbors of each centroid within distance `r`, as in the grouping
+    layers of PointNet++.
+
+    Only the cells of a uniform 3D grid around each centroid are visited, in
+    parallel over the centroids, so no `(N,M)` distance matrix is built.
+
+    To group the features of a single sample:
+
+    .. code-block:: python
+
+        indices, counts = ball_query(points, centroids, r, K)
+        grouped = features[indices.long()]  # (M,K,C)
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)` or `(B,N,3)`.
+        centroids (torch.Tensor): 3D centroids of shape `(M,3)` or `(B,M,3)`.
+        r (float): The radius.
+        K (int): The number of neighbors of each centroid.
+
+    Returns:
+        Tuple[torch.Tensor,torch.Tensor]: `indices` of shape `(M,K)` or `(B,M,K)`, the
+        `K` nearest points within `r` sorted by distance, indices in the points of the
+        same sample, padded by repeating the first one, `-1` if there is none.
+        `counts` of shape `(M,)` or `(B,M)`, the number of neighbors found.
+    '''
+    return csrc.ball_query(points, centroids, r, K)
+
+
+def morton_encode(
+        points: torch.Tensor,
+        bounds: Optional[torch.Tensor]=None,
+        bits: int=21) -> torch.Tensor:
+    '''
+    Compute the Morton (Z-order) code of 3D points.
+
+    Coordinates are quantized in `[0,2^bits)` inside the bounds and their bits
+    are interleaved, x being the least significant.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        bounds (torch.Tensor): optional `xmin/xmax/ymin/ymax/zmin/zmax` of shape `(6,)`,
+            bounding box of the points by default. Points outside are clamped.
+        bits (int): The number of bits per axis, at most 21.
+
+    Returns:
+        torch.Tensor: long codes of shape `(N,)`.
+    '''
+    return csrc.morton_encode(points, bounds, bits)
+
+def hilbert_encode(
+        points: torch.Tensor,
+        bounds: Optional[torch.Tensor]=None,
+        bits: int=21) -> torch.Tensor:
+    '''
+    Compute the Hilbert code of 3D points.
+
+    Same as :func:`morton_encode` along a Hilbert curve, whose consecutive cells
+    are always adjacent.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        bounds (torch.Tensor): optional `xmin/xmax/ymin/ymax/zmin/zmax` of shape `(6,)`,
+            bounding box of the points by default. Points outside are clamped.
+        bits (int): The number of bits per axis, at most 21.
+
+    Returns:
+        torch.Tensor: long codes of shape `(N,)`.
+    '''
+    return csrc.hilbert_encode(points, bounds, bits)
+
+def spatial_sort(
+        points: torch.Tensor,
+        attributes: Sequence[torch.Tensor]=(),
+        curve: str='hilbert',
+        bits: int=10,
+        bounds: Optional[torch.Tensor]=None):
+    '''
+    Reorder 3D points along a space-filling curve to improve memory locality.
+
+    Codes are sorted by a stable parallel radix sort on `3*bits` bits, the
+    points and attributes are gathered in parallel.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        attributes (Sequence[torch.Tensor]): tensors of shape `(N,...)` reordered
+            with the points.
+        curve (str): `'morton'` or `'hilbert'`.
+        bits (int): The number of bits per axis, at most 21.
+        bounds (torch.Tensor): optional `xmin/xmax/ymin/ymax/zmin/zmax` of shape `(6,)`,
+            bounding box of the points by default.
+
+    Returns:
+        the long permutation of shape `(N,)` such that the reordered points are
+        `points[permutation]`, the reordered points of shape `(N,3)` and the
+        reordered attributes.
+    '''
+    permutation, points, attributes = csrc.spatial_sort(points, bounds, bits, curve, list(attributes))
+    return (permutation, points, *attributes)
+
+
+class DynamicGrid2D:
+    '''
+    Mutable 2D grid with the same cells as :func:`build_grid2d`.
+
+    Points are copied into the grid and identified by integer ids, which are
+    reused after removal. Each cell keeps some slack capacity so that inserting
+    or removing a batch of points only costs in proportion to the batch size.
+    Cells that overflow are moved to the end of the indices buffer, the holes
+    left behind are reclaimed by :meth:`compact`, which :meth:`insert` also
+    calls automatically when the holes take up more than half of the buffer
+    and more than 65536 entries; :meth:`remove` never compacts.
+
+    To access the points in a cell `(i,j)`:
+
+    .. code-block:: python
+
+        grid = DynamicGrid2D(xmin, xmax, ymin, ymax, Nx, Ny)
+        ids = grid.insert(points)
+        cells, indices, grid_points = grid.cells(), grid.indices(), grid.points()
+        begin = cells[i,j,0].item()
+        end = cells[i,j,1].item()
+        points_in_cell = grid_points[indices[begin:end]]
+
+    The tensors returned by :meth:`cells`, :meth:`indices` and :meth:`points`
+    share memory with the grid and are invalidated by the next call to
+    :meth:`insert`, :meth:`remove` or :meth:`compact`.
+
+    Args:
+        xmin (float): The minimum x value of the grid.
+        xmax (float): The maximum x value of the grid.
+        ymin (float): The minimum y value of the grid.
+        ymax (float): The maximum y value of the grid.
+        Nx (int): The number of cells in the x direction.
+        Ny (int): The number of cells in the y direction.
+        slack (int): The minimum capacity of a non-empty cell.
+    '''
+    def __init__(
+            self,
+            xmin: float,
+            xmax: float,
+            ymin: float,
+            ymax: float,
+            Nx: int,
+            Ny: int,
+            slack: int=4):
+        self._grid = csrc.DynamicGrid2D(xmin, xmax, ymin, ymax, Nx, Ny, slack)
+
+    def insert(self, points: torch.Tensor) -> torch.Tensor:
+        '''
+        Insert a batch of points.
+
+        Args:
+            points (torch.Tensor): 3D points of shape `(M,3)`.
+
+        Returns:
+            torch.Tensor: int ids of shape `(M,)`, `-1` for points out of the grid.
+        '''
+        return self._grid.insert(points)
+
+    def remove(self, ids: torch.Tensor) -> None:
+        '''
+        Remove a batch of points.
+
+        Args:
+            ids (torch.Tensor): int ids of shape `(M,)` of points in the grid.
+        '''
+        self._grid.remove(ids)
+
+    def compact(self) -> None:
+        '''
+        Reallocate the indices buffer without the holes left by moved cells.
+        '''
+        self._grid.compact()
+
+    def cells(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `cells` of shape `(Nx,Ny,2)` containing the begin/end in `indices` of each cell.
+        '''
+        return self._grid.cells()
+
+    def indices(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `indices` of shape `(L,)` containing ids of points.
+        '''
+        return self._grid.indices()
+
+    def points(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `points` of shape `(P,3)` indexed by ids.
+        '''
+        return self._grid.points()
+
+    def size(self) -> int:
+        '''
+        Returns:
+            int: the number of points in the grid.
+        '''
+        return self._grid.size()
+
+    def garbage(self) -> int:
+        '''
+        Returns:
+            int: the number of entries of the indices buffer left as holes by moved
+            cells, reclaimed by :meth:`compact`.
+        '''
+        return self._grid.garbage()
+
+
+class _Orthtree:
+    def __init__(self, tree):
+        self._tree = tree
+
+    def leaves(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `leaves` of shape `(L,2)` containing the begin/end of points indices in each leaf, in Morton order.
+        '''
+        return self._tree.leaves()
+
+    def indices(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `indices` of shape `(N,)` refering to the original points.
+        '''
+        return self._tree.indices()
+
+    def boxes(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `boxes` of shape `(L,2*D)` containing the `xmin`, `xmax`, `ymin`, `ymax` (and `zmin`, `zmax`) of each leaf.
+        '''
+        return self._tree.boxes()
+
+    def depths(self) -> torch.Tensor:
+        '''
+        Returns:
+            torch.Tensor: `depths` of shape `(L,)` containing the depth of each leaf.
+        '''
+        return self._tree.depths()
+
+    def neighbors(self) -> Tuple[torch.Tensor,torch.Tensor]:
+        '''
+        Find the leaves touching each leaf (by a face, an edge or a corner).
+
+        .. code-block:: python
+
+            offsets, neighbors = tree.neighbors()
+            neighbors_of_leaf = neighbors[offsets[l]:offsets[l+1]]
+
+        Returns:
+            tuple:
+                A tuple containing:
+
+                - `offsets` of shape `(L+1,)`.
+                - `neighbors` of shape `(E,)` containing leaf indices.
+        '''
+        return self._tree.neighbors()
+
+    def locate(self, queries: torch.Tensor) -> torch.Tensor:
+        '''
+        Find the leaf containing each query point.
+
+        Args:
+            queries (torch.Tensor): 3D points of shape `(M,3)`.
+
+        Returns:
+            torch.Tensor: leaf indices of shape `(M,)`, `-1` for points out of the tree.
+        '''
+        return self._tree.locate(queries)
+
+
+class Quadtree(_Orthtree):
+    '''
+    Adaptive quadtree over the x and y coordinates of a set of points.
+
+    The root is the bounding square of the points. A node is split into 4
+    children while it contains more than `max_points` points, so that leaves
+    hold evenly sized work regardless of the density. Empty children are not
+    stored. The tree is built in parallel from the points sorted by Morton code.
+
+    The input points are unchanged. To access the points in a leaf `l`:
+
+    .. code-block:: python
+
+        tree = Quadtree(points, max_points=32)
+        leaves, indices = tree.leaves(), tree.indices()
+        begin = leaves[l,0].item()
+        end = leaves[l,1].item()
+        points_in_leaf = points[indices[begin:end]]
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        max_points (int): The maximum number of points in a leaf, unless it is at `max_depth`.
+        max_depth (int): The maximum depth of the tree, at most 32 (default).
+    '''
+    def __init__(self, points: torch.Tensor, max_points: int=32, max_depth: int=-1):
+        super().__init__(csrc.Quadtree(points, max_points, max_depth))
+
+
+class Octree(_Orthtree):
+    '''
+    Adaptive octree over a set of points.
+
+    Same as :class:`Quadtree` with 8 children per node and 3D boxes.
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        max_points (int): The maximum number of points in a leaf, unless it is at `max_depth`.
+        max_depth (int): The maximum depth of the tree, at most 21 (default).
+    '''
+    def __init__(self, points: torch.Tensor, max_points: int=32, max_depth: int=-1):
+        super().__init__(csrc.Octree(points, max_points, max_depth))
+
+
+class KDTree:
+    '''
+    KD-tree for nearest neighbors search in a set of 3D points.
+
+    Nodes are split at the median along their axis of largest extent until they
+    contain at most `leaf_size` points. The points are copied into the tree in
+    leaf order. Queries run in parallel over the query points.
+
+    .. code-block:: python
+
+        tree = KDTree(points)
+        indices, distances = tree.knn(queries, k=8)
+        neighbors = points[indices[i]]
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        leaf_size (int): The maximum number of points in a leaf.
+    '''
+    def __init__(self, points: torch.Tensor, leaf_size: int=16):
+        self._tree = csrc.KDTree(points, leaf_size)
+
+    def knn(self, queries: torch.Tensor, k: int) -> Tuple[torch.Tensor,torch.Tensor]:
+        '''
+        Find the `k` nearest neighbors of each query point.
+
+        Args:
+            queries (torch.Tensor): 3D points of shape `(M,3)`.
+            k (int): The number of neighbors.
+
+        Returns:
+            tuple:
+                A tuple containing:
+
+                - `indices` of shape `(M,k)` sorted by increasing distance, `-1` if there are less than `k` points.
+                - `distances` of shape `(M,k)` containing euclidean distances, `inf` if there are less than `k` points.
+        '''
+        return self._tree.knn(queries, k)
+
+    def radius(self, queries: torch.Tensor, r: float, max_neighbors: int) -> Tuple[torch.Tensor,torch.Tensor]:
+        '''
+        Find the neighbors within distance `r` of each query point.
+
+        Only the `max_neighbors` nearest ones are kept.
+
+        Args:
+            queries (torch.Tensor): 3D points of shape `(M,3)`.
+            r (float): The search radius.
+            max_neighbors (int): The maximum number of neighbors per query.
+
+        Returns:
+            tuple:
+                A tuple containing:
+
+                - `indices` of shape `(M,max_neighbors)` sorted by increasing distance, padded with `-1`.
+                - `distances` of shape `(M,max_neighbors)` containing euclidean distances, padded with `inf`.
+        '''
+        return self._tree.radius(queries, r, max_neighbors)
+
+    def size(self) -> int:
+        '''
+        Returns:
+            int: the number of points in the tree.
+        '''
+        return self._tree.size()
@@ -0,0 +1,52 @@
+from typing import Optional, Tuple
+import torch
+import torch_points.torch_points_csrc as csrc
+
+def transform_points(
+        points: torch.Tensor,
+        matrices: torch.Tensor,
+        normals: Optional[torch.Tensor]=None,
+        batch: Optional[torch.Tensor]=None,
+        jitter: float=0,
+        seed: Optional[int]=None,
+        inplace: bool=False) -> Tuple[torch.Tensor,Optional[torch.Tensor]]:
+    '''
+    Apply an affine transform to each sample of a batch of points and their
+    normals, and add a gaussian jitter, in a single pass over the points.
+
+    Rotations, scalings, flips and normalizations of an augmentation are composed
+    into one matrix per sample beforehand:
+
+    .. code-block:: python
+
+        # random rotation around z and scaling of each sample
+        angles = 2 * math.pi * torch.rand(B)
+        matrices = torch.eye(4).repeat(B,1,1)
+        matrices[:,0,0] = matrices[:,1,1] = torch.cos(angles)
+        matrices[:,0,1] = -torch.sin(angles)
+        matrices[:,1,0] = torch.sin(angles)
+        matrices[:,:3] *= torch.empty(B,1,1).uniform_(0.8, 1.2)
+        points, normals = transform_points(points, matrices, normals, batch, jitter=0.01)
+
+    Args:
+        points (torch.Tensor): 3D points of shape `(N,3)`.
+        matrices (torch.Tensor): affine transforms of shape `(4,4)` or `(B,4,4)`,
+            the last row is ignored.
+        normals (torch.Tensor): optional normals of shape `(N,3)`, the matrices must
+            then be invertible.
+        batch (torch.Tensor): optional sorted sample of each point of shape `(N,)`,
+            all the points are in one sample by default.
+        jitter (float): The standard deviation of the gaussian noise added to the
+            transformed points.
+        seed (int): seed of the noise, drawn from the default torch generator if None.
+            The result does not depend on the number of threads.
+        inplace (bool): If True, the results are written in `points` and `normals`.
+
+    Returns:
+        Tuple[torch.Tensor,Optional[torch.Tensor]]: transformed points of shape `(N,3)`
+        and normals of shape `(N,3)`, transformed by the inverse transpose of the
+        matrices and rescaled to their input length, None without normals.
+    '''
+    if seed is None:
+        seed = int(torch.randint(2**62, ()).item()) if jitter > 0 else 0
+    return csrc.transform_points(points, normals, matrices, batch, jitter, seed, inplace)